@@ -1,4 +1,5 @@
 #include <gtest/gtest.h>
+#include "parallel_param.h"
 
 int add(int a, int b) {
     return a + b;
@@ -25,3 +26,15 @@ TEST_P(NumberTest, AddTwoNumber) {
 INSTANTIATE_TEST_SUITE_P(AddTestPrefix, NumberTest, 
                          ::testing::Values(std::make_tuple(1, 2, 3), 
                                            (std::make_tuple(4, 5, 9))));
+
+// 大参数集：所有实例在线程池上并行执行（见 common/parallel_param.h）
+PARALLEL_TEST_P(NumberTest, Associative) {
+    int a = std::get<0>(GetParam()), b = std::get<1>(GetParam()), c = std::get<2>(GetParam());
+    EXPECT_EQ(add(add(a, b), c), add(a, add(b, c)));
+    EXPECT_EQ(add(a, b), add(b, a));
+}
+
+INSTANTIATE_PARALLEL_TEST_SUITE_P(Grid, NumberTest,
+                                  ::testing::Combine(::testing::Range(-30, 30),
+                                                     ::testing::Range(-30, 30),
+                                                     ::testing::Range(-30, 30)));
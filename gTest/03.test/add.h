@@ -2,6 +2,23 @@
 #ifndef ADD_H
 #define ADD_H
 
+#include <cstddef>
+
 int add(int a, int b);
 
+// 批量加法：out[i] = a[i] + b[i]，溢出按补码回绕
+// 首次调用前根据 cpuid 选定实现（AVX2 > SSE4.2 > 标量），之后不再判断
+void add_n(const int *a, const int *b, int *out, size_t n);
+
+// 各个实现单独暴露出来，便于测试逐一比对
+void add_n_scalar(const int *a, const int *b, int *out, size_t n);
+void add_n_sse42(const int *a, const int *b, int *out, size_t n);
+void add_n_avx2(const int *a, const int *b, int *out, size_t n);
+
+bool cpu_has_sse42();
+bool cpu_has_avx2();
+
+// 当前 add_n 使用的实现名："avx2"、"sse4.2" 或 "scalar"
+const char *add_n_impl_name();
+
 #endif
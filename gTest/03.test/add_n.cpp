@@ -0,0 +1,102 @@
+#include "add.h"
+#include <immintrin.h>
+
+namespace {
+
+using AddNFunc = void (*)(const int *, const int *, int *, size_t);
+
+struct AddNImpl
+{
+    AddNFunc func;
+    const char *name;
+};
+
+AddNImpl select_impl()
+{
+    if (cpu_has_avx2()) {
+        return {add_n_avx2, "avx2"};
+    }
+    if (cpu_has_sse42()) {
+        return {add_n_sse42, "sse4.2"};
+    }
+    return {add_n_scalar, "scalar"};
+}
+
+const AddNImpl &impl()
+{
+    static const AddNImpl selected = select_impl();
+    return selected;
+}
+
+// 用无符号运算得到与 SIMD 一致的回绕结果，避免有符号溢出的未定义行为
+inline int wrap_add(int a, int b)
+{
+    return static_cast<int>(static_cast<unsigned>(a) + static_cast<unsigned>(b));
+}
+
+}
+
+bool cpu_has_sse42()
+{
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("sse4.2");
+}
+
+bool cpu_has_avx2()
+{
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2");
+}
+
+void add_n(const int *a, const int *b, int *out, size_t n)
+{
+    impl().func(a, b, out, n);
+}
+
+const char *add_n_impl_name()
+{
+    return impl().name;
+}
+
+void add_n_scalar(const int *a, const int *b, int *out, size_t n)
+{
+    for (size_t i = 0; i < n; ++i) {
+        out[i] = wrap_add(a[i], b[i]);
+    }
+}
+
+__attribute__((target("sse4.2")))
+void add_n_sse42(const int *a, const int *b, int *out, size_t n)
+{
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m128i va = _mm_loadu_si128(reinterpret_cast<const __m128i *>(a + i));
+        __m128i vb = _mm_loadu_si128(reinterpret_cast<const __m128i *>(b + i));
+        _mm_storeu_si128(reinterpret_cast<__m128i *>(out + i), _mm_add_epi32(va, vb));
+    }
+    for (; i < n; ++i) {
+        out[i] = wrap_add(a[i], b[i]);
+    }
+}
+
+__attribute__((target("avx2")))
+void add_n_avx2(const int *a, const int *b, int *out, size_t n)
+{
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        __m256i va0 = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(a + i));
+        __m256i vb0 = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(b + i));
+        __m256i va1 = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(a + i + 8));
+        __m256i vb1 = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(b + i + 8));
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(out + i), _mm256_add_epi32(va0, vb0));
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(out + i + 8), _mm256_add_epi32(va1, vb1));
+    }
+    for (; i + 8 <= n; i += 8) {
+        __m256i va = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(a + i));
+        __m256i vb = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(b + i));
+        _mm256_storeu_si256(reinterpret_cast<__m256i *>(out + i), _mm256_add_epi32(va, vb));
+    }
+    for (; i < n; ++i) {
+        out[i] = wrap_add(a[i], b[i]);
+    }
+}
@@ -0,0 +1,65 @@
+#include "add.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+// 各实现的批量加法吞吐（elements/s）
+// 用法：bench_add [数组长度，默认 1048576] [重复次数，默认 200]
+
+using AddNFunc = void (*)(const int *, const int *, int *, size_t);
+
+static void run(const char *name, AddNFunc func, size_t n, int rounds)
+{
+    std::vector<int> a(n), b(n), out(n);
+    for (size_t i = 0; i < n; ++i) {
+        a[i] = static_cast<int>(i);
+        b[i] = static_cast<int>(n - i);
+    }
+    func(a.data(), b.data(), out.data(), n);
+
+    auto start = std::chrono::steady_clock::now();
+    for (int r = 0; r < rounds; ++r) {
+        func(a.data(), b.data(), out.data(), n);
+        // 防止整轮循环被优化掉
+        asm volatile("" : : "r"(out.data()) : "memory");
+    }
+    double s = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::printf("%-10s %8.3f s  %8.2f Gelem/s\n", name, s, n * static_cast<double>(rounds) / s / 1e9);
+}
+
+static void run_pairwise(size_t n, int rounds)
+{
+    std::vector<int> a(n), b(n), out(n);
+    for (size_t i = 0; i < n; ++i) {
+        a[i] = static_cast<int>(i);
+        b[i] = static_cast<int>(n - i);
+    }
+    auto start = std::chrono::steady_clock::now();
+    for (int r = 0; r < rounds; ++r) {
+        for (size_t i = 0; i < n; ++i) {
+            out[i] = add(a[i], b[i]);
+        }
+        asm volatile("" : : "r"(out.data()) : "memory");
+    }
+    double s = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::printf("%-10s %8.3f s  %8.2f Gelem/s\n", "add()", s, n * static_cast<double>(rounds) / s / 1e9);
+}
+
+int main(int argc, char **argv)
+{
+    size_t n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : (1 << 20);
+    int rounds = argc > 2 ? std::atoi(argv[2]) : 200;
+
+    std::printf("n = %zu, rounds = %d, add_n -> %s\n", n, rounds, add_n_impl_name());
+    run_pairwise(n, rounds);
+    run("scalar", add_n_scalar, n, rounds);
+    if (cpu_has_sse42()) {
+        run("sse4.2", add_n_sse42, n, rounds);
+    }
+    if (cpu_has_avx2()) {
+        run("avx2", add_n_avx2, n, rounds);
+    }
+    run("add_n", add_n, n, rounds);
+    return 0;
+}
@@ -1,5 +1,12 @@
 #include "add.h"
 #include <gtest/gtest.h>
+#include "alloc_tracking.h"
+#include "bench_test.h"
+#include "test_timing.h"
+#include <climits>
+#include <random>
+#include <string>
+#include <vector>
 
 class AddTest : public ::testing::Test
 {
@@ -31,7 +38,130 @@ TEST_F(AddTest, cast2) {
 
 }
 
+// 批量加法的每个实现都要与逐个调用 add 的结果逐位一致
+struct AddNParam
+{
+    const char *name;
+    void (*func)(const int *, const int *, int *, size_t);
+    bool (*supported)();
+};
+
+static bool always_supported() { return true; }
+
+class AddNTest : public ::testing::TestWithParam<AddNParam>
+{
+protected:
+    void SetUp() override {
+        if (!GetParam().supported()) {
+            GTEST_SKIP() << GetParam().name << " is not supported on this CPU";
+        }
+    }
+
+    static int reference(int a, int b) {
+        return static_cast<int>(static_cast<unsigned>(a) + static_cast<unsigned>(b));
+    }
+
+    void check(const std::vector<int> &a, const std::vector<int> &b) {
+        std::vector<int> out(a.size() + 1, 0x5a5a5a5a);
+        GetParam().func(a.data(), b.data(), out.data(), a.size());
+        for (size_t i = 0; i < a.size(); ++i) {
+            ASSERT_EQ(out[i], reference(a[i], b[i])) << "n = " << a.size() << ", i = " << i;
+        }
+        // 不能写越界
+        ASSERT_EQ(out[a.size()], 0x5a5a5a5a) << "n = " << a.size();
+    }
+};
+
+TEST_P(AddNTest, MatchesScalarAdd) {
+    for (int i = -100; i <= 100; ++i) {
+        EXPECT_EQ(add(i, 7), reference(i, 7));
+    }
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<int> dist(INT_MIN, INT_MAX);
+    for (size_t n = 0; n <= 67; ++n) {
+        std::vector<int> a(n), b(n);
+        for (size_t i = 0; i < n; ++i) {
+            a[i] = dist(rng);
+            b[i] = dist(rng);
+        }
+        check(a, b);
+    }
+}
+
+TEST_P(AddNTest, WrapsOnOverflow) {
+    std::vector<int> a = {INT_MAX, INT_MIN, -1, 0, INT_MAX, INT_MIN, 1, -1, INT_MAX};
+    std::vector<int> b = {1, -1, INT_MIN, 0, INT_MAX, INT_MIN, -1, 1, INT_MIN};
+    check(a, b);
+}
+
+TEST_P(AddNTest, LargeArray) {
+    std::vector<int> a(100003), b(100003);
+    for (size_t i = 0; i < a.size(); ++i) {
+        a[i] = static_cast<int>(i * 2654435761u);
+        b[i] = static_cast<int>(i * 40503u) - 7;
+    }
+    check(a, b);
+}
+
+INSTANTIATE_TEST_SUITE_P(Impl, AddNTest,
+                         ::testing::Values(AddNParam{"scalar", add_n_scalar, always_supported},
+                                           AddNParam{"sse42", add_n_sse42, cpu_has_sse42},
+                                           AddNParam{"avx2", add_n_avx2, cpu_has_avx2},
+                                           AddNParam{"dispatch", add_n, always_supported}),
+                         [](const ::testing::TestParamInfo<AddNParam> &info) {
+                             return std::string(info.param.name);
+                         });
+
+TEST(AddNDispatch, PicksBestAvailable) {
+    std::string name = add_n_impl_name();
+    if (cpu_has_avx2()) {
+        EXPECT_EQ(name, "avx2");
+    } else if (cpu_has_sse42()) {
+        EXPECT_EQ(name, "sse4.2");
+    } else {
+        EXPECT_EQ(name, "scalar");
+    }
+}
+
+TEST(AddNoAlloc, HotPathDoesNotAllocate) {
+    int a[64], b[64], out[64];
+    for (int i = 0; i < 64; ++i) {
+        a[i] = i;
+        b[i] = -2 * i;
+    }
+    int sum = 0;
+    EXPECT_NO_ALLOC {
+        for (int i = 0; i < 1000; ++i) {
+            sum = add(sum, i);
+        }
+        add_n(a, b, out, 64);
+        add_n_scalar(a, b, out, 64);
+    }
+    EXPECT_EQ(sum, 499500);
+    EXPECT_EQ(out[63], -63);
+}
+
+BENCH_TEST(AddBench, Scalar) {
+    int sum = 0;
+    for (auto _ : state) {
+        sum = add(sum, 3);
+        bench::DoNotOptimize(sum);
+    }
+}
+
+BENCH_TEST_P(AddBench, AddN) {
+    const size_t n = static_cast<size_t>(state.range());
+    std::vector<int> a(n, 1), b(n, 2), out(n);
+    for (auto _ : state) {
+        add_n(a.data(), b.data(), out.data(), n);
+        bench::ClobberMemory();
+    }
+}
+BENCH_INSTANTIATE(Sizes, AddBench, AddN, bench::Range(16, 16384, 8));
+
 int main(int argc, char **argv) {
     testing::InitGoogleTest(&argc, argv);
+    InstallTestTiming();
+    InstallAllocationTracking();
     return RUN_ALL_TESTS();
 }
@@ -0,0 +1,121 @@
+#ifndef __ARRAY_EXPR_H__
+#define __ARRAY_EXPR_H__
+
+#include <cassert>
+#include <cstddef>
+#include <initializer_list>
+#include <type_traits>
+#include <vector>
+
+// 表达式模板：add/sub 作用在数组上时不立即计算，而是返回一个轻量的表达式节点
+// 只有赋值给 Array 时才用一个循环逐元素求值，中间结果不分配内存
+// 例如 Array<int> d = add(sub(a, b), c); 只遍历一次，也只为 d 分配一次
+
+// CRTP 基类，所有数组表达式都继承它
+template <typename E>
+struct ArrayExpr
+{
+    const E &self() const { return static_cast<const E &>(*this); }
+    size_t size() const { return self().size(); }
+    auto operator[](size_t i) const { return self()[i]; }
+};
+
+template <typename T>
+struct is_array_expr
+    : std::is_base_of<ArrayExpr<std::decay_t<T>>, std::decay_t<T>> {};
+
+template <typename T>
+class Array : public ArrayExpr<Array<T>>
+{
+public:
+    using value_type = T;
+
+    Array() = default;
+    explicit Array(size_t n, T value = T()) : _data(n, value) {}
+    Array(std::initializer_list<T> init) : _data(init) {}
+
+    template <typename E>
+    Array(const ArrayExpr<E> &expr) : _data(expr.size())
+    {
+        assign(expr);
+    }
+
+    template <typename E>
+    Array &operator=(const ArrayExpr<E> &expr)
+    {
+        // 大小相同时复用已有缓冲区；逐元素求值，a = add(a, b) 这种写法也安全
+        _data.resize(expr.size());
+        assign(expr);
+        return *this;
+    }
+
+    size_t size() const { return _data.size(); }
+    T operator[](size_t i) const { return _data[i]; }
+    T &operator[](size_t i) { return _data[i]; }
+    const T *data() const { return _data.data(); }
+
+private:
+    template <typename E>
+    void assign(const ArrayExpr<E> &expr)
+    {
+        const E &e = expr.self();
+        const size_t n = _data.size();
+        for (size_t i = 0; i < n; ++i) {
+            _data[i] = e[i];
+        }
+    }
+
+    std::vector<T> _data;
+};
+
+// 叶子节点 Array 按引用保存，中间节点按值保存，这样 auto e = add(sub(a, b), c); 不会悬空
+template <typename E>
+struct ExprStorage { using type = const E; };
+
+template <typename T>
+struct ExprStorage<Array<T>> { using type = const Array<T> &; };
+
+struct AddOp
+{
+    template <typename A, typename B>
+    static auto apply(A a, B b) { return a + b; }
+};
+
+struct SubOp
+{
+    template <typename A, typename B>
+    static auto apply(A a, B b) { return a - b; }
+};
+
+template <typename Op, typename L, typename R>
+class BinaryExpr : public ArrayExpr<BinaryExpr<Op, L, R>>
+{
+public:
+    BinaryExpr(const L &l, const R &r)
+    : _l(l)
+    , _r(r)
+    {
+        assert(l.size() == r.size());
+    }
+
+    size_t size() const { return _l.size(); }
+    auto operator[](size_t i) const { return Op::apply(_l[i], _r[i]); }
+
+private:
+    typename ExprStorage<L>::type _l;
+    typename ExprStorage<R>::type _r;
+};
+
+template <typename L, typename R>
+BinaryExpr<AddOp, L, R> add(const ArrayExpr<L> &a, const ArrayExpr<R> &b)
+{
+    return BinaryExpr<AddOp, L, R>(a.self(), b.self());
+}
+
+template <typename L, typename R>
+BinaryExpr<SubOp, L, R> sub(const ArrayExpr<L> &a, const ArrayExpr<R> &b)
+{
+    return BinaryExpr<SubOp, L, R>(a.self(), b.self());
+}
+
+#endif
@@ -0,0 +1,75 @@
+#include "func.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+// 对比 d = add(sub(a, b), c) 的两种求值方式：
+// eager：每一步都返回一个完整的 std::vector 临时数组
+// fused：表达式模板，一次循环完成
+// 用法：bench_expr [数组长度，默认 4194304] [重复次数，默认 50]
+
+template <typename T>
+std::vector<T> eager_add(const std::vector<T> &a, const std::vector<T> &b)
+{
+    std::vector<T> r(a.size());
+    for (size_t i = 0; i < a.size(); ++i) {
+        r[i] = add(a[i], b[i]);
+    }
+    return r;
+}
+
+template <typename T>
+std::vector<T> eager_sub(const std::vector<T> &a, const std::vector<T> &b)
+{
+    std::vector<T> r(a.size());
+    for (size_t i = 0; i < a.size(); ++i) {
+        r[i] = sub(a[i], b[i]);
+    }
+    return r;
+}
+
+template <typename T>
+void run(const char *type, size_t n, int rounds)
+{
+    std::vector<T> va(n), vb(n), vc(n);
+    Array<T> a(n), b(n), c(n), d(n);
+    for (size_t i = 0; i < n; ++i) {
+        va[i] = a[i] = static_cast<T>(i % 1000);
+        vb[i] = b[i] = static_cast<T>(i % 7);
+        vc[i] = c[i] = static_cast<T>(3);
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    T sink = 0;
+    for (int r = 0; r < rounds; ++r) {
+        std::vector<T> vd = eager_add(eager_sub(va, vb), vc);
+        sink += vd[r % n];
+    }
+    double eager = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    start = std::chrono::steady_clock::now();
+    for (int r = 0; r < rounds; ++r) {
+        d = add(sub(a, b), c);
+        sink += d[r % n];
+    }
+    double fused = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    // eager：sub 读 2n 写 n，add 读 2n 写 n，每轮分配临时数组和结果数组；fused：读 3n 写 n，结果数组复用
+    double mb = static_cast<double>(n) * sizeof(T) / (1 << 20);
+    std::printf("%-7s eager %8.3f s  traffic %8.1f MB/round  allocs 2/round\n",
+                type, eager, 6 * mb);
+    std::printf("%-7s fused %8.3f s  traffic %8.1f MB/round  allocs 0/round  speedup %.2fx  (%g)\n",
+                type, fused, 4 * mb, eager / fused, static_cast<double>(sink));
+}
+
+int main(int argc, char **argv)
+{
+    size_t n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : (1 << 22);
+    int rounds = argc > 2 ? std::atoi(argv[2]) : 50;
+    run<int>("int", n, rounds);
+    run<float>("float", n, rounds);
+    run<long>("long", n, rounds);
+    run<double>("double", n, rounds);
+    return 0;
+}
@@ -1,13 +1,17 @@
 #ifndef __FUNC_H__
 #define __FUNC_H__
 
+#include "array_expr.h"
+#include <type_traits>
+
 // 要测试的两个函数
-template <typename T>
+// 数组表达式走 array_expr.h 里的惰性版本，这里排除掉
+template <typename T, typename = std::enable_if_t<!is_array_expr<T>::value>>
 T add(T a, T b) {
     return a + b;
 }
 
-template <typename T>
+template <typename T, typename = std::enable_if_t<!is_array_expr<T>::value>>
 T sub(T a, T b) {
     return a - b;
 }
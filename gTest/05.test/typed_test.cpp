@@ -1,5 +1,6 @@
 #include "func.h"
 #include <gtest/gtest.h>
+#include "test_timing.h"
 #include <gtest/gtest-typed-test.h>
 
 // 定义模板类
@@ -22,8 +23,77 @@ TYPED_TEST_P(TypedTestClass, SubTest) {
     EXPECT_EQ(a - b, 4);
 }
 
+TYPED_TEST_P(TypedTestClass, ScalarAddSubTest) {
+    EXPECT_EQ(add<TypeParam>(1, 2), 3);
+    EXPECT_EQ(sub<TypeParam>(6, 2), 4);
+}
+
+TYPED_TEST_P(TypedTestClass, ArrayAddTest) {
+    Array<TypeParam> a {1, 2, 3, 4};
+    Array<TypeParam> b {10, 20, 30, 40};
+    Array<TypeParam> c = add(a, b);
+    ASSERT_EQ(c.size(), 4);
+    for (size_t i = 0; i < c.size(); ++i) {
+        EXPECT_EQ(c[i], add(a[i], b[i]));
+    }
+}
+
+TYPED_TEST_P(TypedTestClass, ArraySubTest) {
+    Array<TypeParam> a {10, 20, 30, 40};
+    Array<TypeParam> b {1, 2, 3, 4};
+    Array<TypeParam> c = sub(a, b);
+    ASSERT_EQ(c.size(), 4);
+    for (size_t i = 0; i < c.size(); ++i) {
+        EXPECT_EQ(c[i], sub(a[i], b[i]));
+    }
+}
+
+// add(sub(a, b), c) 与逐元素调用标量版本结果一致
+TYPED_TEST_P(TypedTestClass, FusedChainTest) {
+    const size_t n = 1000;
+    Array<TypeParam> a(n), b(n), c(n), d(n);
+    for (size_t i = 0; i < n; ++i) {
+        a[i] = static_cast<TypeParam>(i * 3);
+        b[i] = static_cast<TypeParam>(i);
+        c[i] = static_cast<TypeParam>(7);
+        d[i] = static_cast<TypeParam>(i % 5);
+    }
+    Array<TypeParam> r = sub(add(sub(a, b), c), d);
+    ASSERT_EQ(r.size(), n);
+    for (size_t i = 0; i < n; ++i) {
+        EXPECT_EQ(r[i], sub(add(sub(a[i], b[i]), c[i]), d[i]));
+    }
+}
+
+// 中间步骤只是表达式节点，求值进已有数组时复用它的缓冲区
+TYPED_TEST_P(TypedTestClass, NoTemporaryTest) {
+    Array<TypeParam> a {5, 6, 7};
+    Array<TypeParam> b {1, 1, 1};
+    Array<TypeParam> c {2, 2, 2};
+
+    auto expr = add(sub(a, b), c);
+    static_assert(!std::is_same<decltype(expr), Array<TypeParam>>::value,
+                  "add/sub on arrays must be lazy");
+    static_assert(!std::is_same<decltype(sub(a, b)), Array<TypeParam>>::value,
+                  "add/sub on arrays must be lazy");
+
+    Array<TypeParam> out(3);
+    const TypeParam *buffer = out.data();
+    out = expr;
+    EXPECT_EQ(out.data(), buffer);
+    EXPECT_EQ(out[0], 6);
+    EXPECT_EQ(out[1], 7);
+    EXPECT_EQ(out[2], 8);
+
+    // 结果数组同时出现在右侧也能正确求值
+    a = add(a, a);
+    EXPECT_EQ(a[0], 10);
+    EXPECT_EQ(a[2], 14);
+}
+
 // 注册测试
-REGISTER_TYPED_TEST_SUITE_P(TypedTestClass, AddTest, SubTest);
+REGISTER_TYPED_TEST_SUITE_P(TypedTestClass, AddTest, SubTest, ScalarAddSubTest,
+                            ArrayAddTest, ArraySubTest, FusedChainTest, NoTemporaryTest);
 
 // 实例化
 using MyTypeClass = ::testing::Types<int, float, long, double>;
@@ -31,5 +101,6 @@ INSTANTIATE_TYPED_TEST_SUITE_P(MyPrefix, TypedTestClass, MyTypeClass);
 
 int main(int argc, char **argv) {
     ::testing::InitGoogleTest(&argc, argv);
+    InstallTestTiming();
     return RUN_ALL_TESTS();
 }
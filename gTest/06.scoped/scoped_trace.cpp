@@ -1,8 +1,11 @@
 #include <gtest/gtest.h>
+#include "parallel_param.h"
+#include "test_timing.h"
 #include <gtest/gtest-param-test.h>
 #include <iostream>
 #include <string>
 #include <tuple>
+#include <vector>
 
 int add(int a, int b) {
     return a + b;
@@ -24,7 +27,29 @@ INSTANTIATE_TEST_SUITE_P(Add, TestAdd, ::testing::Values(
                         std::make_tuple(4, 9, 12),
                         std::make_tuple(4, 9, 13)));
 
+// 同样的测试体放到线程池上跑，失败按参数顺序重放，SCOPED_TRACE 也会带上
+PARALLEL_TEST_P(TestAdd, AddParallel) {
+    auto param = GetParam();
+    SCOPED_TRACE("add(" + std::to_string(std::get<0>(param)) +
+                 ", " + std::to_string(std::get<1>(param)) +
+                 ") = " + std::to_string(std::get<2>(param)));
+    ASSERT_EQ(add(std::get<0>(param), std::get<1>(param)), std::get<2>(param));
+}
+
+static std::vector<std::tuple<int, int, int>> AddTable() {
+    std::vector<std::tuple<int, int, int>> table;
+    for (int a = -200; a < 200; ++a) {
+        for (int b = -200; b < 200; ++b) {
+            table.emplace_back(a, b, a + b);
+        }
+    }
+    return table;
+}
+
+INSTANTIATE_PARALLEL_TEST_SUITE_P(Table, TestAdd, ::testing::ValuesIn(AddTable()));
+
 int main(int argc, char **argv) {
     ::testing::InitGoogleTest(&argc, argv);
+    InstallTestTiming();
     return RUN_ALL_TESTS();
 }
@@ -1,5 +1,6 @@
 #include "Circle.h"
 #include <gtest/gtest.h>
+#include "test_timing.h"
 
 TEST(CircleTest, Area) {
     Circle c(5);
@@ -8,5 +9,6 @@ TEST(CircleTest, Area) {
 
 int main(int argc, char **argv) {
     ::testing::InitGoogleTest(&argc, argv);
+    InstallTestTiming();
     return RUN_ALL_TESTS();
 }
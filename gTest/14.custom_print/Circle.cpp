@@ -1,32 +1,62 @@
+#include "Circle.h"
+#include "circle_batch.h"
 #include <gtest/gtest.h>
 #include <ostream>
+#include <sstream>
+#include <vector>
 
-class Circle {
-public:
-    Circle (double r)
-    : _r(r)
-    , _area(3.14 * _r * _r)
-    {
-        std::cout << "Circle(r)\n";
+Circle make_circle(double r) {
+    return Circle(r);
+}
+
+TEST(CircleTest, case1) {
+    EXPECT_EQ(make_circle(5.0), Circle(4.9));
+}
+
+TEST(CircleBatchTest, AreasMatchCircle) {
+    std::vector<double> radii;
+    for (int i = 0; i < 37; ++i) {
+        radii.push_back(0.5 * i + 0.1);
     }
-    
-    bool operator==(const Circle &other) const {
-        return (_r == other._r) && (_area == other._area);
+    CircleBatch batch(radii);
+    batch.push_back(5.0);
+    ASSERT_EQ(batch.size(), radii.size() + 1);
+    for (size_t i = 0; i < radii.size(); ++i) {
+        Circle c(radii[i]);
+        EXPECT_EQ(batch.radius(i), c.radius());
+        EXPECT_EQ(batch.area(i), c.area()) << "i = " << i;
     }
+    EXPECT_EQ(batch.area(radii.size()), make_circle(5.0).area());
+}
 
-    friend void PrintTo(const Circle &circle, std::ostream *os) {
-        *os << "Circle: r = " << circle._r << ", area = " << circle._area << "\n";
-    }
+TEST(CircleBatchTest, BulkEquality) {
+    CircleBatch a({1.0, 2.0, 3.0});
+    CircleBatch b;
+    b.reserve(3);
+    b.push_back(1.0);
+    b.push_back(2.0);
+    b.push_back(3.0);
+    EXPECT_EQ(a, b);
+    EXPECT_EQ(a.mismatch(b), CircleBatch::npos);
 
-private:
-    double _r;
-    double _area;
-};
+    CircleBatch c({1.0, 2.5, 3.0});
+    EXPECT_NE(a, c);
+    EXPECT_EQ(a.mismatch(c), 1);
 
-Circle make_circle(double r) {
-    return Circle(r);
+    CircleBatch d({1.0, 2.0});
+    EXPECT_NE(a, d);
+    EXPECT_EQ(a.mismatch(d), 2);
 }
 
-TEST(CircleTest, case1) {
-    EXPECT_EQ(make_circle(5.0), Circle(4.9));
+TEST(CircleBatchTest, PrintTo) {
+    CircleBatch batch({1.0, 2.0});
+    EXPECT_EQ(::testing::PrintToString(batch),
+              "CircleBatch: 2 circles\n"
+              "  [0] r = 1, area = 3.14\n"
+              "  [1] r = 2, area = 12.56\n");
+
+    CircleBatch big(std::vector<double>(10, 1.0));
+    std::ostringstream os;
+    PrintTo(big, &os);
+    EXPECT_NE(os.str().find("... 2 more"), std::string::npos);
 }
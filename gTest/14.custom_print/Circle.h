@@ -0,0 +1,32 @@
+#ifndef __CIRCLE_H__
+#define __CIRCLE_H__
+
+#include <iostream>
+#include <ostream>
+
+class Circle {
+public:
+    Circle (double r)
+    : _r(r)
+    , _area(3.14 * _r * _r)
+    {
+        std::cout << "Circle(r)\n";
+    }
+    
+    bool operator==(const Circle &other) const {
+        return (_r == other._r) && (_area == other._area);
+    }
+
+    double radius() const { return _r; }
+    double area() const { return _area; }
+
+    friend void PrintTo(const Circle &circle, std::ostream *os) {
+        *os << "Circle: r = " << circle._r << ", area = " << circle._area << "\n";
+    }
+
+private:
+    double _r;
+    double _area;
+};
+
+#endif
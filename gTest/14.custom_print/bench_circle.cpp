@@ -0,0 +1,66 @@
+#include "Circle.h"
+#include "circle_batch.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+// 对比 std::vector<Circle>（AoS，构造时计算面积）与 CircleBatch（SoA，批量计算面积）
+// 构造 + 求总面积两个阶段分别计时
+// 用法：bench_circle [圆的数量，默认 4000000]
+
+static double seconds(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+int main(int argc, char **argv)
+{
+    size_t n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 4000000;
+    std::vector<double> radii(n);
+    for (size_t i = 0; i < n; ++i) {
+        radii[i] = 0.001 * static_cast<double>(i % 10000);
+    }
+
+    // Circle 的构造函数会打印日志，这里关掉输出，只保留计算和内存布局的开销
+    std::streambuf *saved = std::cout.rdbuf(nullptr);
+    auto start = std::chrono::steady_clock::now();
+    std::vector<Circle> circles;
+    circles.reserve(n);
+    for (double r : radii) {
+        circles.emplace_back(r);
+    }
+    double aosBuild = seconds(start);
+    std::cout.rdbuf(saved);
+
+    start = std::chrono::steady_clock::now();
+    double aosSum = 0;
+    for (const Circle &c : circles) {
+        aosSum += c.area();
+    }
+    double aosScan = seconds(start);
+
+    start = std::chrono::steady_clock::now();
+    CircleBatch batch(radii);
+    double soaBuild = seconds(start);
+
+    start = std::chrono::steady_clock::now();
+    double soaSum = 0;
+    const double *areas = batch.areas();
+    for (size_t i = 0; i < batch.size(); ++i) {
+        soaSum += areas[i];
+    }
+    double soaScan = seconds(start);
+
+    std::printf("n = %zu\n", n);
+    std::printf("vector<Circle>  build %8.3f s  sum areas %8.3f s  (%.6g)\n", aosBuild, aosScan, aosSum);
+    std::printf("CircleBatch     build %8.3f s  sum areas %8.3f s  (%.6g)\n", soaBuild, soaScan, soaSum);
+
+    start = std::chrono::steady_clock::now();
+    std::vector<double> out(n);
+    circle_areas(radii.data(), out.data(), n);
+    double kernel = seconds(start);
+    std::printf("circle_areas    %8.3f s  %8.2f Mcircles/s\n", kernel, n / kernel / 1e6);
+    return 0;
+}
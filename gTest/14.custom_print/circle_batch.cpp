@@ -0,0 +1,100 @@
+#include "circle_batch.h"
+#include <immintrin.h>
+#include <utility>
+
+namespace {
+
+using AreaFunc = void (*)(const double *, double *, size_t);
+
+// 乘法顺序与 Circle 保持一致：(3.14 * r) * r
+void areas_sse2(const double *r, double *area, size_t n)
+{
+    const __m128d pi = _mm_set1_pd(3.14);
+    size_t i = 0;
+    for (; i + 2 <= n; i += 2) {
+        __m128d v = _mm_loadu_pd(r + i);
+        _mm_storeu_pd(area + i, _mm_mul_pd(_mm_mul_pd(pi, v), v));
+    }
+    for (; i < n; ++i) {
+        area[i] = 3.14 * r[i] * r[i];
+    }
+}
+
+__attribute__((target("avx")))
+void areas_avx(const double *r, double *area, size_t n)
+{
+    const __m256d pi = _mm256_set1_pd(3.14);
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m256d v = _mm256_loadu_pd(r + i);
+        _mm256_storeu_pd(area + i, _mm256_mul_pd(_mm256_mul_pd(pi, v), v));
+    }
+    for (; i < n; ++i) {
+        area[i] = 3.14 * r[i] * r[i];
+    }
+}
+
+AreaFunc select_areas()
+{
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx") ? areas_avx : areas_sse2;
+}
+
+}
+
+constexpr size_t CircleBatch::npos;
+
+void circle_areas(const double *r, double *area, size_t n)
+{
+    static const AreaFunc func = select_areas();
+    func(r, area, n);
+}
+
+CircleBatch::CircleBatch(std::vector<double> radii)
+: _r(std::move(radii))
+, _area(_r.size())
+{
+    computeAreas(0);
+}
+
+void CircleBatch::reserve(size_t n)
+{
+    _r.reserve(n);
+    _area.reserve(n);
+}
+
+void CircleBatch::push_back(double r)
+{
+    _r.push_back(r);
+    _area.push_back(0);
+    computeAreas(_r.size() - 1);
+}
+
+void CircleBatch::computeAreas(size_t from)
+{
+    circle_areas(_r.data() + from, _area.data() + from, _r.size() - from);
+}
+
+size_t CircleBatch::mismatch(const CircleBatch &other) const
+{
+    const size_t n = size() < other.size() ? size() : other.size();
+    for (size_t i = 0; i < n; ++i) {
+        if (_r[i] != other._r[i] || _area[i] != other._area[i]) {
+            return i;
+        }
+    }
+    return size() == other.size() ? npos : n;
+}
+
+// 数量很大时只打印前几个，避免失败信息刷屏
+void PrintTo(const CircleBatch &batch, std::ostream *os)
+{
+    const size_t kMaxPrinted = 8;
+    *os << "CircleBatch: " << batch.size() << " circles\n";
+    for (size_t i = 0; i < batch.size() && i < kMaxPrinted; ++i) {
+        *os << "  [" << i << "] r = " << batch._r[i] << ", area = " << batch._area[i] << "\n";
+    }
+    if (batch.size() > kMaxPrinted) {
+        *os << "  ... " << batch.size() - kMaxPrinted << " more\n";
+    }
+}
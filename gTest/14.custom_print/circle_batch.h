@@ -0,0 +1,45 @@
+#ifndef __CIRCLE_BATCH_H__
+#define __CIRCLE_BATCH_H__
+
+#include <cstddef>
+#include <ostream>
+#include <vector>
+
+// 结构数组（SoA）形式的一批圆：半径和面积分别存放在两段连续内存里
+// 面积按 3.14 * r * r 批量计算（AVX / SSE2），与 Circle 的结果逐位一致
+class CircleBatch
+{
+public:
+    static constexpr size_t npos = static_cast<size_t>(-1);
+
+    CircleBatch() = default;
+    explicit CircleBatch(std::vector<double> radii);
+
+    void reserve(size_t n);
+    void push_back(double r);
+
+    size_t size() const { return _r.size(); }
+    double radius(size_t i) const { return _r[i]; }
+    double area(size_t i) const { return _area[i]; }
+    const double *radii() const { return _r.data(); }
+    const double *areas() const { return _area.data(); }
+
+    // 第一处不相等的下标，全部相等返回 npos
+    size_t mismatch(const CircleBatch &other) const;
+
+    bool operator==(const CircleBatch &other) const { return mismatch(other) == npos; }
+    bool operator!=(const CircleBatch &other) const { return !(*this == other); }
+
+    friend void PrintTo(const CircleBatch &batch, std::ostream *os);
+
+private:
+    void computeAreas(size_t from);
+
+    std::vector<double> _r;
+    std::vector<double> _area;
+};
+
+// 对 r[0, n) 批量计算 area[i] = 3.14 * r[i] * r[i]
+void circle_areas(const double *r, double *area, size_t n);
+
+#endif
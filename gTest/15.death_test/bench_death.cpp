@@ -0,0 +1,69 @@
+#include <gtest/gtest.h>
+#include "zygote.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <vector>
+
+// 死亡测试吞吐：gtest fast 风格、threadsafe 风格与 zygote 对比
+// 为了接近真实的大测试进程，main 里在启动 zygote 之后再申请并写满一块堆内存（BENCH_DEATH_HEAP_MB，默认 256）
+// 每种方式执行 BENCH_DEATH_COUNT 次（默认 200）死亡语句，threadsafe 风格只执行其中 1/10
+
+static void die() {
+    std::cerr << "dying\n";
+    std::exit(3);
+}
+
+static int Count() {
+    const char *env = std::getenv("BENCH_DEATH_COUNT");
+    return env ? std::atoi(env) : 200;
+}
+
+static void Report(const char *name, int n, std::chrono::steady_clock::time_point begin) {
+    double sec = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+    std::printf("%-12s %6d deaths  %8.3f s  %10.1f deaths/s\n", name, n, sec, n / sec);
+    std::fflush(stdout);
+}
+
+TEST(DeathBench, GtestFast) {
+    GTEST_FLAG_SET(death_test_style, "fast");
+    int n = Count();
+    auto begin = std::chrono::steady_clock::now();
+    for (int i = 0; i < n; ++i) {
+        EXPECT_EXIT(die(), ::testing::ExitedWithCode(3), "dying");
+    }
+    Report("gtest-fast", n, begin);
+}
+
+TEST(DeathBench, GtestThreadsafe) {
+    GTEST_FLAG_SET(death_test_style, "threadsafe");
+    // 每次都要 exec 并重新跑一遍 main，太慢，只跑 1/10
+    int n = std::max(1, Count() / 10);
+    auto begin = std::chrono::steady_clock::now();
+    for (int i = 0; i < n; ++i) {
+        EXPECT_EXIT(die(), ::testing::ExitedWithCode(3), "dying");
+    }
+    Report("threadsafe", n, begin);
+}
+
+TEST(DeathBench, Zygote) {
+    int n = Count();
+    auto begin = std::chrono::steady_clock::now();
+    for (int i = 0; i < n; ++i) {
+        ZYGOTE_EXPECT_EXIT(die(), ::testing::ExitedWithCode(3), "dying");
+    }
+    Report("zygote", n, begin);
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    DeathZygote::start();
+    const char *env = std::getenv("BENCH_DEATH_HEAP_MB");
+    size_t mb = env ? std::strtoul(env, nullptr, 10) : 256;
+    std::vector<char> heap(mb << 20);
+    std::memset(heap.data(), 1, heap.size());
+    return RUN_ALL_TESTS();
+}
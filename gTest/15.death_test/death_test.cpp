@@ -1,7 +1,11 @@
 #include "gtest/gtest.h"
 #include <gtest/gtest.h>
+#include <gtest/gtest-spi.h>
+#include "zygote.h"
+#include "test_timing.h"
 #include <cstdlib>
 #include <iostream>
+#include <string>
 
 void abort_func() {
     abort();
@@ -35,3 +39,60 @@ TEST(DeathTest, CrashCode) {
 TEST(DeathTest, Normal) {
     EXPECT_EXIT(crash_func(1), ::testing::ExitedWithCode(50), "br.*");
 }
+
+// 同样的用例走 zygote，匹配规则和上面一致
+TEST(ZygoteDeathTest, Crash) {
+    ZYGOTE_ASSERT_DEATH(crash_func(0), "branch.*");
+}
+
+TEST(ZygoteDeathTest, Abort) {
+    ZYGOTE_EXPECT_EXIT(abort_func(), ::testing::KilledBySignal(SIGABRT), ".*");
+}
+
+TEST(ZygoteDeathTest, CrashCode) {
+    ZYGOTE_EXPECT_EXIT(crash_func(0), ::testing::KilledBySignal(SIGSEGV), "a == 0");
+}
+
+TEST(ZygoteDeathTest, Normal) {
+    ZYGOTE_EXPECT_EXIT(crash_func(1), ::testing::ExitedWithCode(50), "br.*");
+}
+
+TEST(ZygoteDeathTest, ReportsLikeGtest) {
+    EXPECT_NONFATAL_FAILURE(ZYGOTE_EXPECT_DEATH(std::cerr << "still alive", ""), "failed to die");
+    EXPECT_NONFATAL_FAILURE(ZYGOTE_EXPECT_EXIT(crash_func(1), ::testing::ExitedWithCode(3), ""),
+                            "Exited with exit status 50");
+    EXPECT_NONFATAL_FAILURE(ZYGOTE_EXPECT_DEATH(crash_func(1), "^a != 0"),
+                            "died but not with expected error");
+}
+
+int g_configured = 0;
+
+TEST(ZygoteDeathTest, SeesStartSnapshot) {
+    if (!DeathZygote::running()) {
+        GTEST_SKIP() << "zygote not running";
+    }
+    // 测试体里的修改发生在 start() 之后，语句看不到
+    g_configured = 5;
+    ZYGOTE_EXPECT_EXIT(std::exit(g_configured), ::testing::ExitedWithCode(0), "");
+    EXPECT_EXIT(std::exit(g_configured), ::testing::ExitedWithCode(5), "");
+    g_configured = 0;
+}
+
+TEST(ZygoteDeathTest, LargeOutput) {
+    // 超过管道容量的输出也能完整收到
+    ZYGOTE_EXPECT_EXIT({
+        std::string line(1000, 'x');
+        for (int i = 0; i < 200; ++i) {
+            std::cerr << line << "\n";
+        }
+        std::cerr << "tail marker";
+        std::exit(7);
+    }, ::testing::ExitedWithCode(7), "tail marker");
+}
+
+int main(int argc, char **argv) {
+    ::testing::InitGoogleTest(&argc, argv);
+    DeathZygote::start();
+    InstallTestTiming();
+    return RUN_ALL_TESTS();
+}
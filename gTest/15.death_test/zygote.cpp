@@ -0,0 +1,237 @@
+#include "zygote.h"
+#include <cerrno>
+#include <csignal>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <dirent.h>
+#include <fcntl.h>
+#include <mutex>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace {
+
+struct Request
+{
+    uintptr_t fn;
+};
+
+// zygote 和它的子进程都往同一个 socket 写应答；SOCK_SEQPACKET 保证消息边界
+struct Reply
+{
+    enum Kind : int { kReturned = 1, kStatus = 2, kForkFailed = 3 };
+    int kind;
+    int value;
+};
+
+int g_sock = -1;        // 父进程一端
+int g_stderr = -1;      // 预先建好的 stderr 管道读端（非阻塞）
+pid_t g_pid = -1;
+std::mutex g_mutex;
+
+bool SendAll(int fd, const void *data, size_t len)
+{
+    while (send(fd, data, len, MSG_NOSIGNAL) < 0) {
+        if (errno != EINTR) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// 在 zygote 的子进程里执行语句；语句返回说明“没死”，和 gtest 一样以 1 退出
+[[noreturn]] void RunChild(int sock, int errWrite, void (*fn)())
+{
+    std::signal(SIGINT, SIG_DFL);
+    dup2(errWrite, STDERR_FILENO);
+    close(errWrite);
+    fn();
+    std::fflush(nullptr);
+    Reply r {Reply::kReturned, 0};
+    SendAll(sock, &r, sizeof(r));
+    _exit(1);
+}
+
+[[noreturn]] void ZygoteLoop(int sock, int errWrite)
+{
+    std::signal(SIGINT, SIG_IGN);
+    while (true) {
+        Request req;
+        ssize_t n = recv(sock, &req, sizeof(req), 0);
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n != sizeof(req)) {
+            _exit(0);   // 父进程退出或者调用了 stop()
+        }
+        pid_t child = fork();
+        if (child == 0) {
+            RunChild(sock, errWrite, reinterpret_cast<void (*)()>(req.fn));
+        }
+        Reply r {Reply::kForkFailed, errno};
+        if (child > 0) {
+            int status = 0;
+            while (waitpid(child, &status, 0) < 0 && errno == EINTR) {
+            }
+            r = Reply {Reply::kStatus, status};
+        }
+        SendAll(sock, &r, sizeof(r));
+    }
+}
+
+// /proc/self/task 下每个线程一个目录
+int ThreadCount()
+{
+    DIR *dir = opendir("/proc/self/task");
+    if (!dir) {
+        return -1;
+    }
+    int n = 0;
+    while (dirent *e = readdir(dir)) {
+        n += e->d_name[0] != '.';
+    }
+    closedir(dir);
+    return n;
+}
+
+void Drain(std::string *out)
+{
+    char buf[4096];
+    ssize_t n;
+    while ((n = read(g_stderr, buf, sizeof(buf))) > 0 || (n < 0 && errno == EINTR)) {
+        if (n > 0 && out) {
+            out->append(buf, n);
+        }
+    }
+}
+
+} // namespace
+
+bool DeathZygote::start()
+{
+    if (g_pid > 0) {
+        return true;
+    }
+    // 快照必须取在任何测试运行之前；有别的线程时 fork 出来的 zygote 可能带着别人持有的锁
+    if (::testing::UnitTest::GetInstance()->current_test_info()) {
+        std::fprintf(stderr, "DeathZygote::start() called inside a test; using gtest death tests instead\n");
+        return false;
+    }
+    if (ThreadCount() > 1) {
+        std::fprintf(stderr, "DeathZygote::start() called with %d threads running; "
+                             "using gtest death tests instead\n", ThreadCount());
+        return false;
+    }
+    int sv[2], pipefd[2];
+    if (socketpair(AF_UNIX, SOCK_SEQPACKET, 0, sv) != 0) {
+        return false;
+    }
+    if (pipe(pipefd) != 0) {
+        close(sv[0]);
+        close(sv[1]);
+        return false;
+    }
+    // 子进程会继承 stdio 的缓冲区，先刷掉，免得输出重复
+    std::fflush(nullptr);
+    pid_t pid = fork();
+    if (pid < 0) {
+        close(sv[0]);
+        close(sv[1]);
+        close(pipefd[0]);
+        close(pipefd[1]);
+        return false;
+    }
+    if (pid == 0) {
+        close(sv[0]);
+        close(pipefd[0]);
+        ZygoteLoop(sv[1], pipefd[1]);
+    }
+    close(sv[1]);
+    close(pipefd[1]);
+    fcntl(pipefd[0], F_SETFL, fcntl(pipefd[0], F_GETFL) | O_NONBLOCK);
+    fcntl(sv[0], F_SETFD, FD_CLOEXEC);
+    fcntl(pipefd[0], F_SETFD, FD_CLOEXEC);
+    g_sock = sv[0];
+    g_stderr = pipefd[0];
+    g_pid = pid;
+    return true;
+}
+
+void DeathZygote::stop()
+{
+    if (g_pid <= 0) {
+        return;
+    }
+    close(g_sock);
+    close(g_stderr);
+    waitpid(g_pid, nullptr, 0);
+    g_sock = g_stderr = -1;
+    g_pid = -1;
+}
+
+bool DeathZygote::running()
+{
+    return g_pid > 0;
+}
+
+DeathZygote::Outcome DeathZygote::run(void (*fn)())
+{
+    std::lock_guard<std::mutex> lock(g_mutex);
+    Outcome out;
+    // 上一个子进程留下的孙进程可能还在写，丢掉
+    Drain(nullptr);
+    std::fflush(nullptr);
+    Request req {reinterpret_cast<uintptr_t>(fn)};
+    if (!SendAll(g_sock, &req, sizeof(req))) {
+        return out;
+    }
+    pollfd fds[2] = {{g_sock, POLLIN, 0}, {g_stderr, POLLIN, 0}};
+    while (true) {
+        if (poll(fds, 2, -1) < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return out;
+        }
+        // 子进程的输出可能超过管道容量，边等边读
+        if (fds[1].revents & POLLIN) {
+            Drain(&out.output);
+        }
+        if (!(fds[0].revents & (POLLIN | POLLHUP | POLLERR))) {
+            continue;
+        }
+        Reply r;
+        ssize_t n = recv(g_sock, &r, sizeof(r), 0);
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n != sizeof(r) || r.kind == Reply::kForkFailed) {
+            return out;
+        }
+        if (r.kind == Reply::kReturned) {
+            out.returned = true;
+            continue;
+        }
+        // 子进程退出前写的内容都已经在管道里了
+        Drain(&out.output);
+        out.status = r.value;
+        out.ok = true;
+        return out;
+    }
+}
+
+std::string ExitSummary(int status)
+{
+    std::string s;
+    if (WIFEXITED(status)) {
+        s = "Exited with exit status " + std::to_string(WEXITSTATUS(status));
+    } else if (WIFSIGNALED(status)) {
+        s = "Terminated by signal " + std::to_string(WTERMSIG(status));
+        if (WCOREDUMP(status)) {
+            s += " (core dumped)";
+        }
+    }
+    return s;
+}
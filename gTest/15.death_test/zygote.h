@@ -0,0 +1,114 @@
+#ifndef __ZYGOTE_H__
+#define __ZYGOTE_H__
+
+#include <gtest/gtest.h>
+#include <sstream>
+#include <string>
+#include <sys/wait.h>
+
+// 死亡测试的 fork-server（zygote）模式
+//
+// gtest 的死亡测试每次都要 fork 整个测试进程（fast 风格），或者 fork + exec 重新启动一遍
+// （threadsafe 风格，要重新初始化运行时、重新注册所有测试），用例一多，大部分时间都花在这上面。
+// zygote 在 main 里初始化完就 fork 出来，那时进程还很小、只有一个线程；
+// 之后每个死亡语句都由 zygote 再 fork 一个子进程执行，子进程的 stderr 接到启动时预先建好的管道上
+//
+// 语句以无捕获 lambda 的函数指针发给 zygote（同一个可执行文件、没有 exec，地址一致），
+// 所以语句里不能引用测试体里的局部变量，用到的话会直接编译失败
+//
+// 注意：语句看到的是 start() 那一刻的进程快照，和 EXPECT_DEATH 不一样
+//   zygote 在 main 里就 fork 好了，之后测试体、SetUp、SetUpTestSuite 对全局变量、静态变量、堆、
+//   打开的文件所做的修改，死亡语句里都看不到；语句只能依赖 main 之前就确定的状态和它自己构造的对象
+//   依赖测试里准备好的状态的死亡测试继续用 EXPECT_DEATH
+//   失败信息里会带上这一提示，方便看出是快照引起的差异
+//
+// 用法：main 里 InitGoogleTest 之后、创建任何线程之前调用 DeathZygote::start()
+// 在测试里调用、或者进程里已经有别的线程时，start() 会在 stderr 上报错并返回 false，宏退回 gtest 的死亡测试
+// 然后用 ZYGOTE_EXPECT_EXIT / ZYGOTE_ASSERT_DEATH 等宏，参数和 gtest 的同名宏一致，
+// stderr 的匹配同样走 gtest 的 MakeDeathTestMatcher（字符串按 ContainsRegex 处理）
+// zygote 没有启动时，这些宏退回 gtest 自己的死亡测试
+class DeathZygote
+{
+public:
+    struct Outcome
+    {
+        bool ok = false;        // 与 zygote 的通信是否正常
+        bool returned = false;  // 语句正常返回了，没有死
+        int status = 0;         // waitpid 的状态
+        std::string output;     // 子进程的 stderr
+    };
+
+    static bool start();
+    static void stop();
+    static bool running();
+
+    // 在 zygote 的子进程里执行 fn，等它结束
+    static Outcome run(void (*fn)());
+};
+
+std::string ExitSummary(int status);
+
+// 附在失败信息后面，提醒语句跑在 start() 时的快照里
+inline const char *ZygoteSnapshotNote()
+{
+    return "\n      Note: the statement ran in a process forked at DeathZygote::start(); "
+           "state changed after that is not visible to it";
+}
+
+// 组装和 gtest 死亡测试一样格式的失败信息
+template <class Predicate>
+::testing::AssertionResult ZygoteDeathResult(const char *statement, void (*fn)(), Predicate predicate,
+                                             const ::testing::Matcher<const std::string &> &matcher)
+{
+    DeathZygote::Outcome out = DeathZygote::run(fn);
+    ::testing::AssertionResult failure = ::testing::AssertionFailure();
+    failure << "Death test: " << statement << "\n";
+    if (!out.ok) {
+        return failure << "    Result: lost connection to the zygote process";
+    }
+    if (out.returned) {
+        return failure << "    Result: failed to die.\n Error msg:\n[  DEATH   ] " << out.output
+                       << ZygoteSnapshotNote();
+    }
+    if (!predicate(out.status)) {
+        return failure << "    Result: died but not with expected exit code:\n            "
+                       << ExitSummary(out.status) << "\nActual msg:\n[  DEATH   ] " << out.output
+                       << ZygoteSnapshotNote();
+    }
+    if (!matcher.Matches(out.output)) {
+        std::ostringstream expected;
+        matcher.DescribeTo(&expected);
+        return failure << "    Result: died but not with expected error.\n  Expected: " << expected.str()
+                       << "\nActual msg:\n[  DEATH   ] " << out.output << ZygoteSnapshotNote();
+    }
+    return ::testing::AssertionSuccess();
+}
+
+// 和 gtest 的 EXPECT_DEATH 一样：以非 0 退出码退出或者被信号杀死都算“死了”
+inline bool ExitedUnsuccessfully(int status)
+{
+    return !(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+}
+
+#define ZYGOTE_DEATH_TEST_(statement, predicate, matcher, fail)                                         \
+    switch (0)                                                                                         \
+    case 0:                                                                                            \
+    default:                                                                                           \
+        if (!DeathZygote::running()) {                                                                 \
+            GTEST_DEATH_TEST_(statement, predicate, matcher, fail);                                    \
+        } else if (::testing::AssertionResult zygote_ar = ZygoteDeathResult(                           \
+                       #statement, +[] { statement; }, predicate,                                      \
+                       ::testing::internal::MakeDeathTestMatcher(matcher))) {                          \
+        } else                                                                                         \
+            fail(zygote_ar.message())
+
+#define ZYGOTE_EXPECT_EXIT(statement, predicate, matcher) \
+    ZYGOTE_DEATH_TEST_(statement, predicate, matcher, GTEST_NONFATAL_FAILURE_)
+#define ZYGOTE_ASSERT_EXIT(statement, predicate, matcher) \
+    ZYGOTE_DEATH_TEST_(statement, predicate, matcher, GTEST_FATAL_FAILURE_)
+#define ZYGOTE_EXPECT_DEATH(statement, matcher) \
+    ZYGOTE_EXPECT_EXIT(statement, ExitedUnsuccessfully, matcher)
+#define ZYGOTE_ASSERT_DEATH(statement, matcher) \
+    ZYGOTE_ASSERT_EXIT(statement, ExitedUnsuccessfully, matcher)
+
+#endif
@@ -1,6 +1,8 @@
 #include <gtest/gtest.h>
+#include "test_timing.h"
 
 int main(int argc, char **argv) {
     testing::InitGoogleTest(&argc, argv);
+    InstallTestTiming();
     return RUN_ALL_TESTS();
 }
@@ -0,0 +1,108 @@
+#ifndef __ASYNC_LOGGER_H__
+#define __ASYNC_LOGGER_H__
+
+#include "file.h"
+#include "mpsc_queue.h"
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <mutex>
+#include <string>
+#include <thread>
+
+// 异步 Logger：write 只把消息拷贝进无锁队列，由后台线程统一写入 File
+// File::write 变慢时，调用方的开销不受影响
+// 写入失败无法同步返回给调用方，通过 failures() 查询
+class AsyncLogger
+{
+public:
+    explicit AsyncLogger(File *f)
+    : _file(f)
+    , _worker(&AsyncLogger::run, this)
+    {}
+
+    ~AsyncLogger()
+    {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _stop.store(true);
+        }
+        _cv.notify_one();
+        _worker.join();
+    }
+
+    AsyncLogger(const AsyncLogger &) = delete;
+    AsyncLogger &operator=(const AsyncLogger &) = delete;
+
+    bool init()
+    {
+        return _file->open("log.txt") == 0;
+    }
+
+    // 返回 true 表示消息已入队
+    bool write(const char *buf, size_t size)
+    {
+        if (_stop.load(std::memory_order_relaxed)) {
+            return false;
+        }
+        _queue.push(std::string(buf, size));
+        _enqueued.fetch_add(1, std::memory_order_relaxed);
+        if (_sleeping.load(std::memory_order_seq_cst)) {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _cv.notify_one();
+        }
+        return true;
+    }
+
+    // 阻塞直到调用前已入队的消息全部写入 File
+    void flush()
+    {
+        size_t target = _enqueued.load(std::memory_order_relaxed);
+        while (_written.load(std::memory_order_acquire) < target) {
+            std::this_thread::yield();
+        }
+    }
+
+    size_t written() const { return _written.load(std::memory_order_acquire); }
+    size_t failures() const { return _failures.load(std::memory_order_relaxed); }
+
+private:
+    void run()
+    {
+        std::string record;
+        for (;;) {
+            if (_queue.pop(record)) {
+                if (_file->write(record.data(), record.size()) != static_cast<int>(record.size())) {
+                    _failures.fetch_add(1, std::memory_order_relaxed);
+                }
+                _written.fetch_add(1, std::memory_order_release);
+                continue;
+            }
+            if (!_queue.empty()) {
+                // 生产者正在链接节点，稍等即可
+                std::this_thread::yield();
+                continue;
+            }
+            if (_stop.load()) {
+                return;
+            }
+            std::unique_lock<std::mutex> lock(_mutex);
+            _sleeping.store(true, std::memory_order_seq_cst);
+            _cv.wait(lock, [this] { return !_queue.empty() || _stop.load(); });
+            _sleeping.store(false, std::memory_order_relaxed);
+        }
+    }
+
+    File *_file = nullptr;
+    MpscQueue<std::string> _queue;
+    std::atomic<size_t> _enqueued{0};
+    std::atomic<size_t> _written{0};
+    std::atomic<size_t> _failures{0};
+    std::atomic<bool> _sleeping{false};
+    std::atomic<bool> _stop{false};
+    std::mutex _mutex;
+    std::condition_variable _cv;
+    std::thread _worker;
+};
+
+#endif
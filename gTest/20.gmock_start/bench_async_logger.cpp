@@ -0,0 +1,107 @@
+#include "async_logger.h"
+#include "logger.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// 模拟慢磁盘：每次 write 固定阻塞一段时间
+// 对比同步 Logger 与 AsyncLogger 在生产者一侧的写入延迟分布
+// 用法：bench_async_logger [线程数，默认 4] [每线程消息数，默认 2000] [磁盘延迟 us，默认 50]
+// 样本数（线程数 × 消息数）至少 1000 时 p99 才有意义
+
+class SlowFile : public File
+{
+public:
+    explicit SlowFile(std::chrono::microseconds delay) : _delay(delay) {}
+
+    int open(const char *) override { return 0; }
+    int close() override { return 0; }
+    int read(char *, size_t) override { return 0; }
+    int write(const char *, size_t size) override
+    {
+        std::this_thread::sleep_for(_delay);
+        return static_cast<int>(size);
+    }
+
+private:
+    std::chrono::microseconds _delay;
+};
+
+// 同步 Logger 本身不是线程安全的，多线程共享时由调用方加锁
+struct LockedLogger
+{
+    explicit LockedLogger(File *f) : logger(f) {}
+
+    bool write(const char *buf, size_t size)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        return logger.write(buf, size);
+    }
+
+    Logger logger;
+    std::mutex mutex;
+};
+
+template <typename LoggerType>
+std::vector<double> run(LoggerType &logger, int threads, int messages)
+{
+    static const char kLine[] = "2024-01-01 00:00:00.000 INFO  request handled\n";
+    std::vector<std::vector<double>> perThread(threads);
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; ++t) {
+        workers.emplace_back([&, t] {
+            auto &out = perThread[t];
+            out.reserve(messages);
+            for (int i = 0; i < messages; ++i) {
+                auto start = std::chrono::steady_clock::now();
+                logger.write(kLine, sizeof(kLine) - 1);
+                auto end = std::chrono::steady_clock::now();
+                out.push_back(std::chrono::duration<double, std::micro>(end - start).count());
+            }
+        });
+    }
+    for (auto &w : workers) {
+        w.join();
+    }
+    std::vector<double> all;
+    for (auto &v : perThread) {
+        all.insert(all.end(), v.begin(), v.end());
+    }
+    std::sort(all.begin(), all.end());
+    return all;
+}
+
+static void report(const char *name, const std::vector<double> &lat)
+{
+    auto at = [&lat](double q) { return lat[static_cast<size_t>(q * (lat.size() - 1))]; };
+    std::printf("%-12s p50 %10.2f us  p99 %10.2f us  p99.9 %10.2f us  max %10.2f us\n",
+                name, at(0.5), at(0.99), at(0.999), lat.back());
+}
+
+int main(int argc, char **argv)
+{
+    int threads = argc > 1 ? std::atoi(argv[1]) : 4;
+    int messages = argc > 2 ? std::atoi(argv[2]) : 2000;
+    std::chrono::microseconds delay(argc > 3 ? std::atoi(argv[3]) : 50);
+
+    SlowFile file(delay);
+    {
+        LockedLogger logger(&file);
+        report("Logger", run(logger, threads, messages));
+    }
+    {
+        AsyncLogger logger(&file);
+        auto lat = run(logger, threads, messages);
+        logger.flush();
+        report("AsyncLogger", lat);
+        // 生产者一侧不应被慢磁盘拖住：p99 要远低于一次磁盘写的耗时
+        double p99 = lat[static_cast<size_t>(0.99 * (lat.size() - 1))];
+        std::printf("AsyncLogger p99 / disk delay = %.3f (%zu samples)%s\n", p99 / delay.count(), lat.size(),
+                    p99 < delay.count() / 4.0 ? "" : "  <-- producer is blocked by the disk");
+    }
+    return 0;
+}
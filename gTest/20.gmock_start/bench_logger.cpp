@@ -0,0 +1,61 @@
+#include "logger.h"
+#include "posix_file.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <unistd.h>
+
+// 对比逐条写入（Logger）与批量写入（BufferedLogger）的吞吐
+// 用法：bench_logger [行数，默认 1000000]
+
+static const char kLine[] = "2024-01-01 00:00:00.000 INFO  [worker-1] request handled in 42us\n";
+
+template <typename LoggerType>
+double run(LoggerType &logger, size_t lines)
+{
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < lines; ++i) {
+        logger.write(kLine, sizeof(kLine) - 1);
+    }
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+static void report(const char *name, size_t lines, double seconds)
+{
+    std::printf("%-16s %10zu lines  %8.3f s  %12.0f lines/s\n",
+                name, lines, seconds, lines / seconds);
+}
+
+int main(int argc, char **argv)
+{
+    size_t lines = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000000;
+    char path[] = "/tmp/bench_logger_XXXXXX";
+    int fd = mkstemp(path);
+    if (fd < 0) {
+        std::perror("mkstemp");
+        return 1;
+    }
+    ::close(fd);
+
+    {
+        PosixFile file;
+        file.open(path);
+        Logger logger(&file);
+        report("Logger", lines, run(logger, lines));
+    }
+    ::truncate(path, 0);
+    {
+        PosixFile file;
+        file.open(path);
+        BufferedLogger logger(&file);
+        auto start = std::chrono::steady_clock::now();
+        run(logger, lines);
+        logger.flush();
+        double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        report("BufferedLogger", lines, seconds);
+    }
+
+    ::unlink(path);
+    return 0;
+}
@@ -0,0 +1,97 @@
+#include "mmap_file.h"
+#include "posix_file.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <unistd.h>
+#include <vector>
+
+// 对比 PosixFile（read/write 拷贝）与 MmapFile（memcpy 追加 + 视图读取）
+// 先逐行追加生成日志，再顺序扫描统计行数
+// 用法：bench_mmap_file [日志大小 MB，默认 1024]
+
+static const char kLine[] = "2024-01-01 00:00:00.000 INFO  [worker-1] request handled in 42us\n";
+static const size_t kLineSize = sizeof(kLine) - 1;
+static const size_t kChunk = 1 << 20;
+
+static double seconds(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+static size_t countLines(const char *p, size_t n)
+{
+    size_t lines = 0;
+    const char *end = p + n;
+    while ((p = static_cast<const char *>(std::memchr(p, '\n', end - p))) != nullptr) {
+        ++lines;
+        ++p;
+    }
+    return lines;
+}
+
+static void report(const char *name, const char *phase, size_t bytes, double s)
+{
+    std::printf("%-10s %-6s %8.3f s  %10.1f MB/s\n", name, phase, s, bytes / s / (1 << 20));
+}
+
+template <typename FileType, typename Scan>
+void run(const char *name, const char *path, size_t lines, Scan scan)
+{
+    ::unlink(path);
+    size_t bytes = lines * kLineSize;
+    {
+        FileType file;
+        file.open(path);
+        auto start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < lines; ++i) {
+            file.write(kLine, kLineSize);
+        }
+        report(name, "append", bytes, seconds(start));
+    }
+    {
+        FileType file;
+        file.open(path);
+        auto start = std::chrono::steady_clock::now();
+        size_t counted = scan(file);
+        report(name, "scan", bytes, seconds(start));
+        if (counted != lines) {
+            std::printf("%s: expected %zu lines, counted %zu\n", name, lines, counted);
+        }
+    }
+}
+
+int main(int argc, char **argv)
+{
+    size_t mb = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1024;
+    size_t lines = (mb << 20) / kLineSize;
+    char path[] = "/tmp/bench_mmap_XXXXXX";
+    int fd = mkstemp(path);
+    if (fd < 0) {
+        std::perror("mkstemp");
+        return 1;
+    }
+    ::close(fd);
+
+    run<PosixFile>("PosixFile", path, lines, [](PosixFile &file) {
+        std::vector<char> buf(kChunk);
+        size_t count = 0;
+        int n;
+        while ((n = file.read(buf.data(), buf.size())) > 0) {
+            count += countLines(buf.data(), n);
+        }
+        return count;
+    });
+    run<MmapFile>("MmapFile", path, lines, [](MmapFile &file) {
+        size_t count = 0;
+        ByteView v;
+        while ((v = file.readView(kChunk)).size > 0) {
+            count += countLines(v.data, v.size);
+        }
+        return count;
+    });
+
+    ::unlink(path);
+    return 0;
+}
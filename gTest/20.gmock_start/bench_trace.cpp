@@ -0,0 +1,76 @@
+#include "file_trace.h"
+#include "logger.h"
+#include "posix_file.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <unistd.h>
+
+// 同一份 Logger / BufferedLogger 负载：写真实文件（同时录制）与按 trace 回放的耗时对比
+// 用法：bench_trace [行数，默认 1000000]
+
+static const char kLine[] = "2024-01-01 00:00:00.000 INFO  [worker-1] request handled in 42us\n";
+
+static double seconds(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+template <typename LoggerType>
+static void writeLines(LoggerType &logger, size_t lines)
+{
+    for (size_t i = 0; i < lines; ++i) {
+        logger.write(kLine, sizeof(kLine) - 1);
+    }
+}
+
+template <typename LoggerType>
+static void compare(const char *name, const char *path, size_t lines)
+{
+    ::truncate(path, 0);
+    PosixFile real;
+    TraceRecorder recorder(&real);
+    recorder.open(path);
+    auto start = std::chrono::steady_clock::now();
+    {
+        LoggerType logger(&recorder);
+        writeLines(logger, lines);
+    }
+    double recordSec = seconds(start);
+    recorder.close();
+
+    FileTrace trace;
+    trace.assign(recorder.serialize());
+    ReplayFile replay(trace);
+    replay.open(path);
+    start = std::chrono::steady_clock::now();
+    {
+        LoggerType logger(&replay);
+        writeLines(logger, lines);
+    }
+    double replaySec = seconds(start);
+    replay.close();
+
+    std::printf("%-16s %8zu calls  disk+record %8.3f s  replay %8.3f s  (%s)\n", name, trace.size(),
+                recordSec, replaySec, replay.done() ? "matched" : "MISMATCH");
+}
+
+int main(int argc, char **argv)
+{
+    size_t lines = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000000;
+    char path[] = "/tmp/bench_trace_XXXXXX";
+    int fd = mkstemp(path);
+    if (fd < 0) {
+        std::perror("mkstemp");
+        return 1;
+    }
+    ::close(fd);
+
+    std::streambuf *saved = std::cout.rdbuf(nullptr);   // Logger 的构造函数会打印
+    compare<Logger>("Logger", path, lines);
+    compare<BufferedLogger>("BufferedLogger", path, lines);
+    std::cout.rdbuf(saved);
+
+    ::unlink(path);
+    return 0;
+}
@@ -0,0 +1,16 @@
+#ifndef __FILE_H__
+#define __FILE_H__
+
+#include <cstddef>
+
+class File 
+{
+public:
+    virtual ~File() = default;
+    virtual int open(const char *name) = 0;
+    virtual int close() = 0;
+    virtual int read(char *buf, size_t size) = 0;
+    virtual int write(const char *buf, size_t size) = 0;
+};
+
+#endif
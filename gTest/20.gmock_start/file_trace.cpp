@@ -0,0 +1,262 @@
+#include "file_trace.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+static const char kMagic[4] = {'F', 'T', 'R', 'C'};
+static const uint16_t kVersion = 1;
+
+// 每次处理 8 字节的乘法-移位哈希，比逐字节的 FNV 快得多，对回放校验足够
+uint32_t TraceHash(const char *data, size_t size)
+{
+    if (!data) {
+        return 0;
+    }
+    const uint64_t kMul = 0x9E3779B97F4A7C15ull;
+    uint64_t h = size * kMul;
+    size_t i = 0;
+    for (; i + 8 <= size; i += 8) {
+        uint64_t w;
+        std::memcpy(&w, data + i, 8);
+        h = (h ^ w) * kMul;
+        h ^= h >> 29;
+    }
+    uint64_t tail = 0;
+    std::memcpy(&tail, data + i, size - i);
+    h = (h ^ tail) * kMul;
+    h ^= h >> 32;
+    return static_cast<uint32_t>(h);
+}
+
+FileTrace::~FileTrace()
+{
+    reset();
+}
+
+void FileTrace::reset()
+{
+    if (_map) {
+        ::munmap(_map, _mapSize);
+        _map = nullptr;
+    }
+    _bytes.clear();
+    _header = nullptr;
+    _records = nullptr;
+    _data = nullptr;
+}
+
+bool FileTrace::load(const char *path)
+{
+    reset();
+    int fd = ::open(path, O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+    struct stat st;
+    if (::fstat(fd, &st) != 0 || st.st_size < static_cast<off_t>(sizeof(TraceHeader))) {
+        ::close(fd);
+        return false;
+    }
+    void *p = ::mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (p == MAP_FAILED) {
+        return false;
+    }
+    _map = p;
+    _mapSize = st.st_size;
+    if (!parse(static_cast<const char *>(p), _mapSize)) {
+        reset();
+        return false;
+    }
+    return true;
+}
+
+bool FileTrace::assign(std::vector<char> bytes)
+{
+    reset();
+    _bytes = std::move(bytes);
+    if (!parse(_bytes.data(), _bytes.size())) {
+        reset();
+        return false;
+    }
+    return true;
+}
+
+bool FileTrace::parse(const char *base, size_t size)
+{
+    if (size < sizeof(TraceHeader)) {
+        return false;
+    }
+    const TraceHeader *h = reinterpret_cast<const TraceHeader *>(base);
+    if (std::memcmp(h->magic, kMagic, 4) != 0 || h->version != kVersion) {
+        return false;
+    }
+    // 分开比较，dataSize 是文件里读来的 64 位数，直接相加可能溢出
+    size_t fixed = sizeof(TraceHeader) + static_cast<size_t>(h->count) * sizeof(TraceRecord);
+    if (size < fixed || h->dataSize > size - fixed) {
+        return false;
+    }
+    const TraceRecord *records = reinterpret_cast<const TraceRecord *>(base + sizeof(TraceHeader));
+    // 回放时每条 read 从数据区取走 min(ret, size) 字节，总数不能超出数据区
+    if (h->flags & kTraceReadData) {
+        uint64_t payload = 0;
+        for (uint32_t i = 0; i < h->count; ++i) {
+            const TraceRecord &r = records[i];
+            if (r.op == static_cast<uint8_t>(TraceOp::Read) && r.ret > 0) {
+                payload += std::min(static_cast<uint32_t>(r.ret), r.size);
+            }
+        }
+        if (payload > h->dataSize) {
+            return false;
+        }
+    }
+    _header = h;
+    _records = records;
+    _data = base + fixed;
+    return true;
+}
+
+TraceRecorder::TraceRecorder(File *inner, uint16_t flags)
+: _inner(inner)
+, _flags(flags)
+{}
+
+void TraceRecorder::append(TraceOp op, int ret, const char *data, size_t size)
+{
+    TraceRecord r = {};
+    r.op = static_cast<uint8_t>(op);
+    r.ret = ret;
+    r.size = static_cast<uint32_t>(size);
+    r.hash = (_flags & kTraceHashes) ? TraceHash(data, size) : 0;
+    _records.push_back(r);
+}
+
+int TraceRecorder::open(const char *name)
+{
+    int ret = _inner->open(name);
+    append(TraceOp::Open, ret, name, name ? std::strlen(name) : 0);
+    return ret;
+}
+
+int TraceRecorder::close()
+{
+    int ret = _inner->close();
+    append(TraceOp::Close, ret, nullptr, 0);
+    return ret;
+}
+
+int TraceRecorder::read(char *buf, size_t size)
+{
+    int ret = _inner->read(buf, size);
+    size_t got = ret > 0 ? std::min(static_cast<size_t>(ret), size) : 0;
+    // read 的哈希取实际读到的数据
+    append(TraceOp::Read, ret, buf, got);
+    _records.back().size = static_cast<uint32_t>(size);
+    if ((_flags & kTraceReadData) && got > 0) {
+        _data.insert(_data.end(), buf, buf + got);
+    }
+    return ret;
+}
+
+int TraceRecorder::write(const char *buf, size_t size)
+{
+    int ret = _inner->write(buf, size);
+    append(TraceOp::Write, ret, buf, size);
+    return ret;
+}
+
+std::vector<char> TraceRecorder::serialize() const
+{
+    TraceHeader h = {};
+    std::memcpy(h.magic, kMagic, 4);
+    h.version = kVersion;
+    h.flags = _flags;
+    h.count = static_cast<uint32_t>(_records.size());
+    h.dataSize = _data.size();
+
+    size_t recordBytes = _records.size() * sizeof(TraceRecord);
+    std::vector<char> out(sizeof(h) + recordBytes + _data.size());
+    std::memcpy(out.data(), &h, sizeof(h));
+    if (recordBytes) {
+        std::memcpy(out.data() + sizeof(h), _records.data(), recordBytes);
+    }
+    if (!_data.empty()) {
+        std::memcpy(out.data() + sizeof(h) + recordBytes, _data.data(), _data.size());
+    }
+    return out;
+}
+
+bool TraceRecorder::save(const char *path) const
+{
+    std::vector<char> bytes = serialize();
+    FILE *f = std::fopen(path, "wb");
+    if (!f) {
+        return false;
+    }
+    bool ok = std::fwrite(bytes.data(), 1, bytes.size(), f) == bytes.size();
+    return std::fclose(f) == 0 && ok;
+}
+
+const TraceRecord *ReplayFile::next(TraceOp op, const char *data, size_t size)
+{
+    if (_pos >= _trace.size() || _trace[_pos].op != static_cast<uint8_t>(op)) {
+        ++_mismatches;
+        return nullptr;
+    }
+    const TraceRecord *r = &_trace[_pos++];
+    if (_verify) {
+        bool hashed = (_trace.flags() & kTraceHashes) && op != TraceOp::Read;
+        if (r->size != size || (hashed && r->hash != TraceHash(data, size))) {
+            ++_mismatches;
+        }
+    }
+    return r;
+}
+
+int ReplayFile::open(const char *name)
+{
+    const TraceRecord *r = next(TraceOp::Open, name, name ? std::strlen(name) : 0);
+    return r ? r->ret : -1;
+}
+
+int ReplayFile::close()
+{
+    const TraceRecord *r = next(TraceOp::Close, nullptr, 0);
+    return r ? r->ret : -1;
+}
+
+int ReplayFile::read(char *buf, size_t size)
+{
+    const TraceRecord *r = next(TraceOp::Read, nullptr, size);
+    if (!r) {
+        return -1;
+    }
+    size_t got = r->ret > 0 ? std::min(static_cast<size_t>(r->ret), size) : 0;
+    if (got > 0) {
+        if (_trace.flags() & kTraceReadData) {
+            // parse 已经保证数据区够用，这里仍然按剩余长度截断，不足的部分填 0 并计入不符
+            size_t left = _trace.dataSize() - std::min(_dataPos, _trace.dataSize());
+            size_t copy = std::min(got, left);
+            std::memcpy(buf, _trace.data() + _dataPos, copy);
+            if (copy < got) {
+                std::memset(buf + copy, 0, got - copy);
+                ++_mismatches;
+            }
+            // 调用方给的缓冲区比录制时小，多出来的数据也要跳过
+            _dataPos += std::min(std::min(static_cast<size_t>(r->ret), static_cast<size_t>(r->size)), left);
+        } else {
+            std::memset(buf, 0, got);
+        }
+    }
+    return r->ret;
+}
+
+int ReplayFile::write(const char *buf, size_t size)
+{
+    const TraceRecord *r = next(TraceOp::Write, buf, size);
+    return r ? r->ret : -1;
+}
@@ -0,0 +1,144 @@
+#ifndef __FILE_TRACE_H__
+#define __FILE_TRACE_H__
+
+#include "file.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// File 调用序列的录制与回放
+//
+// TraceRecorder 包在真实的 File 外面，原样转发调用，同时记下每次调用的操作、大小、返回值
+// 和（可选的）数据哈希；ReplayFile 按录下的顺序把返回值原样交回去，不碰磁盘
+//
+// 文件格式（小端，整体可以直接 mmap 使用）：
+//   TraceHeader                          24 字节
+//   TraceRecord[count]                   每条 16 字节
+//   read 数据区                          仅在 kTraceReadData 时存在，按 read 记录的顺序依次拼接
+// open 的 size/hash 对应文件名，read/write 对应数据；close 的 size/hash 为 0
+enum class TraceOp : uint8_t
+{
+    Open = 1,
+    Close = 2,
+    Read = 3,
+    Write = 4,
+};
+
+enum TraceFlags : uint16_t
+{
+    kTraceHashes = 1,    // 记录数据哈希，回放时校验写入的内容
+    kTraceReadData = 2,  // 记录 read 读到的数据，回放时原样返回（否则填 0）
+};
+
+struct TraceHeader
+{
+    char magic[4];
+    uint16_t version;
+    uint16_t flags;
+    uint32_t count;
+    uint32_t reserved;
+    uint64_t dataSize;
+};
+
+struct TraceRecord
+{
+    uint8_t op;
+    uint8_t reserved[3];
+    int32_t ret;
+    uint32_t size;
+    uint32_t hash;
+};
+
+static_assert(sizeof(TraceHeader) == 24, "trace header layout");
+static_assert(sizeof(TraceRecord) == 16, "trace record layout");
+
+uint32_t TraceHash(const char *data, size_t size);
+
+// 一份只读的 trace：从文件 mmap 进来，或者持有一块内存
+class FileTrace
+{
+public:
+    FileTrace() = default;
+    ~FileTrace();
+
+    FileTrace(const FileTrace &) = delete;
+    FileTrace &operator=(const FileTrace &) = delete;
+
+    bool load(const char *path);
+    bool assign(std::vector<char> bytes);
+
+    uint16_t flags() const { return _header->flags; }
+    size_t size() const { return _header ? _header->count : 0; }
+    const TraceRecord &operator[](size_t i) const { return _records[i]; }
+    const char *data() const { return _data; }
+    size_t dataSize() const { return _header ? _header->dataSize : 0; }
+
+private:
+    bool parse(const char *base, size_t size);
+    void reset();
+
+    void *_map = nullptr;
+    size_t _mapSize = 0;
+    std::vector<char> _bytes;
+    const TraceHeader *_header = nullptr;
+    const TraceRecord *_records = nullptr;
+    const char *_data = nullptr;
+};
+
+class TraceRecorder : public File
+{
+public:
+    explicit TraceRecorder(File *inner, uint16_t flags = kTraceHashes);
+
+    int open(const char *name) override;
+    int close() override;
+    int read(char *buf, size_t size) override;
+    int write(const char *buf, size_t size) override;
+
+    size_t size() const { return _records.size(); }
+    std::vector<char> serialize() const;
+    bool save(const char *path) const;
+
+private:
+    void append(TraceOp op, int ret, const char *data, size_t size);
+
+    File *_inner;
+    uint16_t _flags;
+    std::vector<TraceRecord> _records;
+    std::vector<char> _data;
+};
+
+// 按 trace 回放：每次调用取下一条记录，操作不符时返回 -1 且不前进；
+// 大小或（开启哈希时）内容不符时照常返回录下的值，但计入 mismatches()
+class ReplayFile : public File
+{
+public:
+    explicit ReplayFile(const FileTrace &trace)
+    : _trace(trace)
+    {}
+
+    int open(const char *name) override;
+    int close() override;
+    int read(char *buf, size_t size) override;
+    int write(const char *buf, size_t size) override;
+
+    // 关掉内容校验，只按顺序回放返回值
+    void setVerify(bool verify) { _verify = verify; }
+
+    size_t position() const { return _pos; }
+    size_t remaining() const { return _trace.size() - _pos; }
+    size_t mismatches() const { return _mismatches; }
+    // 全部回放完且没有任何不符
+    bool done() const { return remaining() == 0 && _mismatches == 0; }
+
+private:
+    const TraceRecord *next(TraceOp op, const char *data, size_t size);
+
+    const FileTrace &_trace;
+    size_t _pos = 0;
+    size_t _dataPos = 0;
+    size_t _mismatches = 0;
+    bool _verify = true;
+};
+
+#endif
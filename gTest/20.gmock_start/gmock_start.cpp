@@ -2,39 +2,21 @@
 #include <cstddef>
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <future>
 #include <iostream>
-
-class File 
-{
-public:
-    virtual int open(const char *name) = 0;
-    virtual int close() = 0;
-    virtual int read(char *buf, size_t size) = 0;
-    virtual int write(const char *buf, size_t size) = 0;
-};
-
-class Logger
-{
-public:
-    Logger(File *f)
-    : _file(f)
-    {
-        std::cout << "Logger(File *) \n";
-    }
-
-    bool init()
-    {
-        return _file->open("log.txt") == 0;
-    }
-
-    bool write(const char *buf, size_t size)
-    {
-        return _file->write(buf, size) == size;
-    }
-
-private:
-    File *_file = nullptr;
-};
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+#include "async_logger.h"
+#include "file_trace.h"
+#include "logger.h"
+#include "mmap_file.h"
+#include "posix_file.h"
 
 class MockFile : public File
 {
@@ -77,3 +59,430 @@ TEST(GMockDemo, WriteFailed)
     EXPECT_FALSE(logger.write(nullptr, 10));
     EXPECT_FALSE(logger.write(nullptr, 10));
 }
+
+TEST(BufferedLoggerDemo, FlushOnThreshold)
+{
+    MockFile mockFile;
+    EXPECT_CALL(mockFile, write(_, 12))
+        .WillOnce(Return(12));
+
+    BufferedLogger logger(&mockFile, 16);
+    EXPECT_TRUE(logger.write("abcdef", 6));
+    EXPECT_TRUE(logger.write("ghijkl", 6));
+    EXPECT_EQ(logger.buffered(), 12);
+
+    // 第三条放不下，先把前两条一次写出
+    EXPECT_TRUE(logger.write("mnopqr", 6));
+    EXPECT_EQ(logger.buffered(), 6);
+
+    testing::Mock::VerifyAndClearExpectations(&mockFile);
+    EXPECT_CALL(mockFile, write(_, 6))
+        .WillOnce(Return(6));
+}
+
+TEST(BufferedLoggerDemo, ExplicitFlush)
+{
+    MockFile mockFile;
+    EXPECT_CALL(mockFile, write(_, 10))
+        .WillOnce(Return(10));
+
+    BufferedLogger logger(&mockFile, 1024);
+    EXPECT_TRUE(logger.write("hello", 5));
+    EXPECT_TRUE(logger.write("world", 5));
+    EXPECT_TRUE(logger.flush());
+    EXPECT_EQ(logger.buffered(), 0);
+    EXPECT_TRUE(logger.flush());
+}
+
+TEST(BufferedLoggerDemo, FlushOnDestruction)
+{
+    MockFile mockFile;
+    EXPECT_CALL(mockFile, write(_, 5))
+        .WillOnce(Return(5));
+    {
+        BufferedLogger logger(&mockFile, 1024);
+        EXPECT_TRUE(logger.write("hello", 5));
+    }
+}
+
+TEST(BufferedLoggerDemo, LargeMessageBypassesBuffer)
+{
+    MockFile mockFile;
+    testing::InSequence seq;
+    EXPECT_CALL(mockFile, write(_, 3))
+        .WillOnce(Return(3));
+    EXPECT_CALL(mockFile, write(_, 32))
+        .WillOnce(Return(32));
+
+    BufferedLogger logger(&mockFile, 16);
+    std::string big(32, 'x');
+    EXPECT_TRUE(logger.write("abc", 3));
+    EXPECT_TRUE(logger.write(big.data(), big.size()));
+    EXPECT_EQ(logger.buffered(), 0);
+}
+
+TEST(BufferedLoggerDemo, FlushFailed)
+{
+    MockFile mockFile;
+    EXPECT_CALL(mockFile, write(_, 8))
+        .WillOnce(Return(-1));
+
+    BufferedLogger logger(&mockFile, 8);
+    EXPECT_TRUE(logger.write("abcd", 4));
+    EXPECT_TRUE(logger.write("efgh", 4));
+    EXPECT_FALSE(logger.flush());
+    EXPECT_EQ(logger.buffered(), 0);
+}
+
+TEST(PosixFileDemo, WriteThenRead)
+{
+    char path[] = "/tmp/posix_file_XXXXXX";
+    int fd = mkstemp(path);
+    ASSERT_GE(fd, 0);
+    ::close(fd);
+
+    {
+        PosixFile file;
+        ASSERT_EQ(file.open(path), 0);
+        BufferedLogger logger(&file, 8);
+        EXPECT_TRUE(logger.write("line1\n", 6));
+        EXPECT_TRUE(logger.write("line2\n", 6));
+    }
+
+    PosixFile file;
+    ASSERT_EQ(file.open(path), 0);
+    char buf[32] = {};
+    EXPECT_EQ(file.read(buf, sizeof(buf)), 12);
+    EXPECT_STREQ(buf, "line1\nline2\n");
+    EXPECT_EQ(file.close(), 0);
+    ::unlink(path);
+}
+
+using ::testing::Invoke;
+
+TEST(AsyncLoggerDemo, WritesInOrder)
+{
+    MockFile mockFile;
+    std::vector<std::string> lines;
+    EXPECT_CALL(mockFile, write(_, _))
+        .Times(3)
+        .WillRepeatedly(Invoke([&lines](const char *buf, size_t size) {
+            lines.emplace_back(buf, size);
+            return static_cast<int>(size);
+        }));
+
+    AsyncLogger logger(&mockFile);
+    EXPECT_TRUE(logger.write("a", 1));
+    EXPECT_TRUE(logger.write("bb", 2));
+    EXPECT_TRUE(logger.write("ccc", 3));
+    logger.flush();
+
+    EXPECT_THAT(lines, testing::ElementsAre("a", "bb", "ccc"));
+    EXPECT_EQ(logger.failures(), 0);
+}
+
+TEST(AsyncLoggerDemo, MultipleProducers)
+{
+    const int kThreads = 4;
+    const int kPerThread = 500;
+    MockFile mockFile;
+    std::atomic<int> bytes{0};
+    EXPECT_CALL(mockFile, write(_, _))
+        .Times(kThreads * kPerThread)
+        .WillRepeatedly(Invoke([&bytes](const char *, size_t size) {
+            bytes += static_cast<int>(size);
+            return static_cast<int>(size);
+        }));
+
+    AsyncLogger logger(&mockFile);
+    std::vector<std::thread> producers;
+    for (int t = 0; t < kThreads; ++t) {
+        producers.emplace_back([&logger] {
+            for (int i = 0; i < kPerThread; ++i) {
+                logger.write("message\n", 8);
+            }
+        });
+    }
+    for (auto &t : producers) {
+        t.join();
+    }
+    logger.flush();
+
+    EXPECT_EQ(logger.written(), static_cast<size_t>(kThreads * kPerThread));
+    EXPECT_EQ(bytes.load(), kThreads * kPerThread * 8);
+}
+
+TEST(AsyncLoggerDemo, WriteFailedIsCounted)
+{
+    MockFile mockFile;
+    EXPECT_CALL(mockFile, write(_, 10))
+        .WillOnce(Return(10))
+        .WillOnce(Return(-1))
+        .WillOnce(Return(5));
+
+    AsyncLogger logger(&mockFile);
+    for (int i = 0; i < 3; ++i) {
+        EXPECT_TRUE(logger.write("0123456789", 10));
+    }
+    logger.flush();
+    EXPECT_EQ(logger.failures(), 2);
+}
+
+// write 只入队，从不在调用方线程上调用后端；不看耗时，延迟分布见 bench_async_logger
+TEST(AsyncLoggerDemo, WriteNeverCallsFileOnProducerThread)
+{
+    const int kMessages = 100;
+    std::promise<void> release;
+    std::shared_future<void> released = release.get_future().share();
+    std::mutex idsMutex;
+    std::vector<std::thread::id> writerIds;
+
+    MockFile mockFile;
+    EXPECT_CALL(mockFile, write(_, _))
+        .Times(kMessages)
+        .WillRepeatedly(Invoke([&](const char *, size_t size) {
+            {
+                std::lock_guard<std::mutex> lock(idsMutex);
+                writerIds.push_back(std::this_thread::get_id());
+            }
+            // 后端卡住期间生产者必须照样能写完；有上限，写法错了也只是失败而不会挂住
+            released.wait_for(std::chrono::seconds(10));
+            return static_cast<int>(size);
+        }));
+
+    AsyncLogger logger(&mockFile);
+    for (int i = 0; i < kMessages; ++i) {
+        EXPECT_TRUE(logger.write("slow disk message\n", 18));
+    }
+    // 所有消息都已入队，后端最多在处理第一条
+    EXPECT_LE(logger.written(), 1u);
+    release.set_value();
+    logger.flush();
+    EXPECT_EQ(logger.written(), static_cast<size_t>(kMessages));
+
+    std::lock_guard<std::mutex> lock(idsMutex);
+    ASSERT_EQ(writerIds.size(), static_cast<size_t>(kMessages));
+    for (std::thread::id id : writerIds) {
+        EXPECT_NE(id, std::this_thread::get_id());
+    }
+}
+
+class MmapFileTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        int fd = mkstemp(_path);
+        ASSERT_GE(fd, 0);
+        ::close(fd);
+    }
+    void TearDown() override
+    {
+        ::unlink(_path);
+    }
+
+    char _path[32] = "/tmp/mmap_file_XXXXXX";
+};
+
+TEST_F(MmapFileTest, AppendAndReadBack)
+{
+    MmapFile file(4096);
+    ASSERT_EQ(file.open(_path), 0);
+
+    Logger logger(&file);
+    EXPECT_TRUE(logger.write("hello ", 6));
+    EXPECT_TRUE(logger.write("mmap\n", 5));
+    EXPECT_EQ(file.size(), 11);
+
+    char buf[16] = {};
+    EXPECT_EQ(file.read(buf, 6), 6);
+    EXPECT_EQ(file.read(buf + 6, sizeof(buf)), 5);
+    EXPECT_STREQ(buf, "hello mmap\n");
+    EXPECT_EQ(file.read(buf, sizeof(buf)), 0);
+}
+
+TEST_F(MmapFileTest, GrowsByExtents)
+{
+    MmapFile file(4096);
+    ASSERT_EQ(file.open(_path), 0);
+    EXPECT_EQ(file.capacity(), 4096);
+
+    std::string chunk(1000, 'a');
+    for (int i = 0; i < 10; ++i) {
+        chunk.assign(1000, static_cast<char>('a' + i));
+        ASSERT_EQ(file.write(chunk.data(), chunk.size()), 1000);
+    }
+    EXPECT_EQ(file.size(), 10000);
+    EXPECT_EQ(file.capacity(), 12288);
+
+    for (int i = 0; i < 10; ++i) {
+        ByteView v = file.readView(1000);
+        ASSERT_EQ(v.size, 1000);
+        EXPECT_EQ(std::string(v.data, v.size), std::string(1000, static_cast<char>('a' + i)));
+    }
+    EXPECT_EQ(file.readView(1).size, 0);
+}
+
+TEST_F(MmapFileTest, ViewIsClampedAndDoesNotMoveReadPosition)
+{
+    MmapFile file(4096);
+    ASSERT_EQ(file.open(_path), 0);
+    ASSERT_EQ(file.write("0123456789", 10), 10);
+
+    ByteView v = file.view(6, 100);
+    EXPECT_EQ(std::string(v.data, v.size), "6789");
+    EXPECT_EQ(file.view(10, 1).size, 0);
+
+    ByteView head = file.readView(3);
+    EXPECT_EQ(std::string(head.data, head.size), "012");
+}
+
+TEST_F(MmapFileTest, CloseTruncatesToLogicalSize)
+{
+    {
+        MmapFile file(4096);
+        ASSERT_EQ(file.open(_path), 0);
+        ASSERT_EQ(file.write("abc", 3), 3);
+        EXPECT_EQ(file.close(), 0);
+    }
+
+    MmapFile file(4096);
+    ASSERT_EQ(file.open(_path), 0);
+    EXPECT_EQ(file.size(), 3);
+    ASSERT_EQ(file.write("def", 3), 3);
+    ByteView v = file.view(0, 6);
+    EXPECT_EQ(std::string(v.data, v.size), "abcdef");
+}
+
+class FileTraceTest : public MmapFileTest {};
+
+TEST_F(FileTraceTest, ReplayBufferedLoggerWithoutDisk)
+{
+    const std::string line = "2024-01-01 00:00:00 INFO request handled\n";
+    PosixFile real;
+    TraceRecorder recorder(&real);
+    {
+        ASSERT_EQ(recorder.open(_path), 0);
+        BufferedLogger logger(&recorder, 256);
+        for (int i = 0; i < 100; ++i) {
+            ASSERT_TRUE(logger.write(line.data(), line.size()));
+        }
+    }
+    EXPECT_EQ(recorder.close(), 0);
+    ASSERT_GT(recorder.size(), 10);
+
+    FileTrace trace;
+    ASSERT_TRUE(trace.assign(recorder.serialize()));
+    ReplayFile replay(trace);
+    {
+        EXPECT_EQ(replay.open(_path), 0);
+        BufferedLogger logger(&replay, 256);
+        for (int i = 0; i < 100; ++i) {
+            EXPECT_TRUE(logger.write(line.data(), line.size()));
+        }
+    }
+    EXPECT_EQ(replay.close(), 0);
+    EXPECT_TRUE(replay.done());
+}
+
+TEST_F(FileTraceTest, SaveLoadAndDetectMismatch)
+{
+    MockFile mockFile;
+    EXPECT_CALL(mockFile, open(_)).WillOnce(Return(0));
+    EXPECT_CALL(mockFile, write(_, 5)).WillOnce(Return(5)).WillOnce(Return(-1));
+    TraceRecorder recorder(&mockFile);
+    Logger logger(&recorder);
+    EXPECT_TRUE(logger.init());
+    EXPECT_TRUE(logger.write("hello", 5));
+    EXPECT_FALSE(logger.write("world", 5));
+    ASSERT_TRUE(recorder.save(_path));
+
+    FileTrace trace;
+    ASSERT_TRUE(trace.load(_path));
+    ASSERT_EQ(trace.size(), 3);
+    EXPECT_EQ(trace[0].op, static_cast<uint8_t>(TraceOp::Open));
+    EXPECT_EQ(trace[2].ret, -1);
+
+    // 同样的调用序列：返回值与录制时一致，不需要逐个写 WillOnce
+    ReplayFile same(trace);
+    Logger replayed(&same);
+    EXPECT_TRUE(replayed.init());
+    EXPECT_TRUE(replayed.write("hello", 5));
+    EXPECT_FALSE(replayed.write("world", 5));
+    EXPECT_TRUE(same.done());
+
+    // 内容不同：照常返回，但计入不符；操作不符：返回 -1 且不前进
+    ReplayFile other(trace);
+    EXPECT_EQ(other.open("log.txt"), 0);
+    EXPECT_EQ(other.write("HELLO", 5), 5);
+    EXPECT_EQ(other.close(), -1);
+    EXPECT_EQ(other.mismatches(), 2);
+    EXPECT_EQ(other.remaining(), 1);
+    EXPECT_FALSE(other.done());
+}
+
+TEST_F(FileTraceTest, ReplayReadData)
+{
+    MockFile mockFile;
+    EXPECT_CALL(mockFile, read(_, _))
+        .WillOnce([](char *buf, size_t) { std::memcpy(buf, "abc", 3); return 3; })
+        .WillOnce(Return(0));
+    TraceRecorder recorder(&mockFile, kTraceHashes | kTraceReadData);
+    char buf[8] = {};
+    EXPECT_EQ(recorder.read(buf, sizeof(buf)), 3);
+    EXPECT_EQ(recorder.read(buf, sizeof(buf)), 0);
+
+    FileTrace trace;
+    ASSERT_TRUE(trace.assign(recorder.serialize()));
+    EXPECT_EQ(trace.dataSize(), 3);
+    ReplayFile replay(trace);
+    char out[8] = {};
+    EXPECT_EQ(replay.read(out, sizeof(out)), 3);
+    EXPECT_STREQ(out, "abc");
+    EXPECT_EQ(replay.read(out, sizeof(out)), 0);
+    EXPECT_TRUE(replay.done());
+}
+
+TEST(FileTraceFormat, RejectsBadInput)
+{
+    FileTrace trace;
+    EXPECT_FALSE(trace.assign(std::vector<char>(10)));
+    EXPECT_FALSE(trace.assign(std::vector<char>(sizeof(TraceHeader), 'x')));
+    EXPECT_FALSE(trace.load("/nonexistent/trace.bin"));
+
+    MockFile mockFile;
+    EXPECT_CALL(mockFile, close()).WillOnce(Return(0));
+    TraceRecorder recorder(&mockFile);
+    recorder.close();
+    std::vector<char> bytes = recorder.serialize();
+    bytes.pop_back();  // 截断
+    EXPECT_FALSE(trace.assign(bytes));
+}
+
+TEST(FileTraceFormat, RejectsReadPayloadBeyondData)
+{
+    MockFile mockFile;
+    EXPECT_CALL(mockFile, read(_, _)).WillOnce([](char *buf, size_t) { std::memcpy(buf, "abcd", 4); return 4; });
+    TraceRecorder recorder(&mockFile, kTraceReadData);
+    char buf[8];
+    recorder.read(buf, sizeof(buf));
+    std::vector<char> bytes = recorder.serialize();
+
+    FileTrace trace;
+    ASSERT_TRUE(trace.assign(bytes));
+
+    // read 记录声称读到 6 字节，数据区只有 4 字节
+    TraceRecord r;
+    std::memcpy(&r, bytes.data() + sizeof(TraceHeader), sizeof(r));
+    r.ret = 6;
+    std::memcpy(bytes.data() + sizeof(TraceHeader), &r, sizeof(r));
+    EXPECT_FALSE(trace.assign(bytes));
+
+    // dataSize 大到和其余部分相加会溢出
+    std::vector<char> huge = recorder.serialize();
+    TraceHeader h;
+    std::memcpy(&h, huge.data(), sizeof(h));
+    h.dataSize = UINT64_MAX;
+    std::memcpy(huge.data(), &h, sizeof(h));
+    EXPECT_FALSE(trace.assign(huge));
+}
@@ -0,0 +1,100 @@
+#ifndef __LOGGER_H__
+#define __LOGGER_H__
+
+#include "file.h"
+#include <cstddef>
+#include <cstring>
+#include <iostream>
+#include <memory>
+
+class Logger
+{
+public:
+    Logger(File *f)
+    : _file(f)
+    {
+        std::cout << "Logger(File *) \n";
+    }
+
+    bool init()
+    {
+        return _file->open("log.txt") == 0;
+    }
+
+    bool write(const char *buf, size_t size)
+    {
+        return _file->write(buf, size) == size;
+    }
+
+private:
+    File *_file = nullptr;
+};
+
+// 带缓冲的 Logger：消息先拷贝进固定容量的缓冲区，攒够一批再调用一次 File::write
+// 刷新时机：缓冲区放不下新消息、显式 flush()、析构
+// 超过容量的大消息先刷掉已有内容，再直接写入 File，不经过缓冲区
+class BufferedLogger
+{
+public:
+    static constexpr size_t kDefaultCapacity = 64 * 1024;
+
+    explicit BufferedLogger(File *f, size_t capacity = kDefaultCapacity)
+    : _file(f)
+    , _buf(new char[capacity])
+    , _capacity(capacity)
+    {}
+
+    ~BufferedLogger()
+    {
+        flush();
+    }
+
+    BufferedLogger(const BufferedLogger &) = delete;
+    BufferedLogger &operator=(const BufferedLogger &) = delete;
+
+    bool init()
+    {
+        return _file->open("log.txt") == 0;
+    }
+
+    // 返回 false 表示本次写入触发的刷新失败（失败的那一批数据被丢弃）
+    bool write(const char *buf, size_t size)
+    {
+        bool ok = true;
+        if (_used + size > _capacity) {
+            ok = flush();
+        }
+        if (size > _capacity) {
+            return writeAll(buf, size) && ok;
+        }
+        std::memcpy(_buf.get() + _used, buf, size);
+        _used += size;
+        return ok;
+    }
+
+    bool flush()
+    {
+        if (_used == 0) {
+            return true;
+        }
+        bool ok = writeAll(_buf.get(), _used);
+        _used = 0;
+        return ok;
+    }
+
+    size_t buffered() const { return _used; }
+    size_t capacity() const { return _capacity; }
+
+private:
+    bool writeAll(const char *buf, size_t size)
+    {
+        return _file->write(buf, size) == static_cast<int>(size);
+    }
+
+    File *_file = nullptr;
+    std::unique_ptr<char[]> _buf;
+    size_t _capacity = 0;
+    size_t _used = 0;
+};
+
+#endif
@@ -0,0 +1,127 @@
+#include "mmap_file.h"
+#include <algorithm>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+static size_t roundUp(size_t n, size_t align)
+{
+    return (n + align - 1) / align * align;
+}
+
+MmapFile::MmapFile(size_t extent)
+: _extent(roundUp(std::max<size_t>(extent, 1), static_cast<size_t>(sysconf(_SC_PAGESIZE))))
+{}
+
+MmapFile::~MmapFile()
+{
+    close();
+}
+
+int MmapFile::open(const char *name)
+{
+    if (_fd >= 0) {
+        return -1;
+    }
+    _fd = ::open(name, O_RDWR | O_CREAT, 0644);
+    if (_fd < 0) {
+        return -1;
+    }
+    struct stat st;
+    if (::fstat(_fd, &st) != 0) {
+        close();
+        return -1;
+    }
+    _size = static_cast<size_t>(st.st_size);
+    _readPos = 0;
+    if (!reserve(std::max(_size, _extent))) {
+        close();
+        return -1;
+    }
+    return 0;
+}
+
+int MmapFile::close()
+{
+    if (_fd < 0) {
+        return -1;
+    }
+    int ret = 0;
+    if (_base) {
+        ::munmap(_base, _capacity);
+        _base = nullptr;
+    }
+    if (::ftruncate(_fd, static_cast<off_t>(_size)) != 0) {
+        ret = -1;
+    }
+    if (::close(_fd) != 0) {
+        ret = -1;
+    }
+    _fd = -1;
+    _size = _capacity = _readPos = 0;
+    return ret;
+}
+
+int MmapFile::read(char *buf, size_t size)
+{
+    if (_fd < 0) {
+        return -1;
+    }
+    ByteView v = readView(size);
+    std::memcpy(buf, v.data, v.size);
+    return static_cast<int>(v.size);
+}
+
+int MmapFile::write(const char *buf, size_t size)
+{
+    if (_fd < 0 || !reserve(_size + size)) {
+        return -1;
+    }
+    std::memcpy(_base + _size, buf, size);
+    _size += size;
+    return static_cast<int>(size);
+}
+
+ByteView MmapFile::readView(size_t size)
+{
+    ByteView v = view(_readPos, size);
+    _readPos += v.size;
+    return v;
+}
+
+ByteView MmapFile::view(size_t offset, size_t size) const
+{
+    ByteView v;
+    if (offset >= _size) {
+        return v;
+    }
+    v.data = _base + offset;
+    v.size = std::min(size, _size - offset);
+    return v;
+}
+
+// 按 extent 整数倍扩容：先 fallocate 真正占住磁盘块，避免写映射区时因磁盘满触发 SIGBUS
+bool MmapFile::reserve(size_t need)
+{
+    if (need <= _capacity && _base) {
+        return true;
+    }
+    size_t newCap = roundUp(std::max(need, _capacity + _extent), _extent);
+    if (::posix_fallocate(_fd, 0, static_cast<off_t>(newCap)) != 0) {
+        return false;
+    }
+    void *p;
+    if (_base) {
+        p = ::mremap(_base, _capacity, newCap, MREMAP_MAYMOVE);
+    } else {
+        p = ::mmap(nullptr, newCap, PROT_READ | PROT_WRITE, MAP_SHARED, _fd, 0);
+    }
+    if (p == MAP_FAILED) {
+        return false;
+    }
+    _base = static_cast<char *>(p);
+    _capacity = newCap;
+    return true;
+}
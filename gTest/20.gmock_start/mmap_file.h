@@ -0,0 +1,54 @@
+#ifndef __MMAP_FILE_H__
+#define __MMAP_FILE_H__
+
+#include "file.h"
+#include <cstddef>
+
+// 指向映射区的只读视图，不拥有内存
+// 映射区扩容（write 触发）或 close 之后失效
+struct ByteView
+{
+    const char *data = nullptr;
+    size_t size = 0;
+};
+
+// 基于 mmap 的 File 实现，只支持追加写
+// 文件按 extent 预分配并整体映射，write 直接 memcpy 进映射区，read 从映射区拷出
+// readView/view 直接借出映射区内存，省掉一次拷贝
+// close 时把文件截断回实际写入的长度
+class MmapFile : public File
+{
+public:
+    static constexpr size_t kDefaultExtent = 16 * 1024 * 1024;
+
+    explicit MmapFile(size_t extent = kDefaultExtent);
+    ~MmapFile() override;
+
+    MmapFile(const MmapFile &) = delete;
+    MmapFile &operator=(const MmapFile &) = delete;
+
+    int open(const char *name) override;
+    int close() override;
+    int read(char *buf, size_t size) override;
+    int write(const char *buf, size_t size) override;
+
+    // 从读位置开始借出至多 size 字节，并推进读位置
+    ByteView readView(size_t size);
+    // 借出 [offset, offset + size) 区间，越界部分被截掉，不影响读位置
+    ByteView view(size_t offset, size_t size) const;
+
+    size_t size() const { return _size; }
+    size_t capacity() const { return _capacity; }
+
+private:
+    bool reserve(size_t need);
+
+    int _fd = -1;
+    char *_base = nullptr;
+    size_t _extent;
+    size_t _size = 0;
+    size_t _capacity = 0;
+    size_t _readPos = 0;
+};
+
+#endif
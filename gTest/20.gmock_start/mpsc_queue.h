@@ -0,0 +1,73 @@
+#ifndef __MPSC_QUEUE_H__
+#define __MPSC_QUEUE_H__
+
+#include <atomic>
+#include <utility>
+
+// 无锁的多生产者/单消费者队列（Vyukov 侵入式链表）
+// push 只有一次 exchange + 一次 store，任意线程都可以调用
+// pop/empty 只能由唯一的消费者线程调用
+template <typename T>
+class MpscQueue
+{
+public:
+    MpscQueue()
+    {
+        Node *stub = new Node();
+        _head.store(stub, std::memory_order_relaxed);
+        _tail = stub;
+    }
+
+    ~MpscQueue()
+    {
+        while (_tail) {
+            Node *next = _tail->next.load(std::memory_order_relaxed);
+            delete _tail;
+            _tail = next;
+        }
+    }
+
+    MpscQueue(const MpscQueue &) = delete;
+    MpscQueue &operator=(const MpscQueue &) = delete;
+
+    void push(T value)
+    {
+        Node *node = new Node(std::move(value));
+        Node *prev = _head.exchange(node, std::memory_order_seq_cst);
+        prev->next.store(node, std::memory_order_release);
+    }
+
+    // 生产者已经 exchange 但还没链接 next 时，这里会暂时返回 false
+    bool pop(T &out)
+    {
+        Node *tail = _tail;
+        Node *next = tail->next.load(std::memory_order_acquire);
+        if (next == nullptr) {
+            return false;
+        }
+        out = std::move(next->value);
+        _tail = next;
+        delete tail;
+        return true;
+    }
+
+    bool empty() const
+    {
+        return _head.load(std::memory_order_seq_cst) == _tail;
+    }
+
+private:
+    struct Node
+    {
+        Node() = default;
+        explicit Node(T v) : value(std::move(v)) {}
+
+        std::atomic<Node *> next{nullptr};
+        T value;
+    };
+
+    alignas(64) std::atomic<Node *> _head;
+    alignas(64) Node *_tail;
+};
+
+#endif
@@ -0,0 +1,54 @@
+#include "posix_file.h"
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+
+PosixFile::~PosixFile()
+{
+    close();
+}
+
+int PosixFile::open(const char *name)
+{
+    if (_fd >= 0) {
+        return -1;
+    }
+    _fd = ::open(name, O_RDWR | O_CREAT | O_APPEND, 0644);
+    return _fd >= 0 ? 0 : -1;
+}
+
+int PosixFile::close()
+{
+    if (_fd < 0) {
+        return -1;
+    }
+    int ret = ::close(_fd);
+    _fd = -1;
+    return ret;
+}
+
+int PosixFile::read(char *buf, size_t size)
+{
+    ssize_t n;
+    do {
+        n = ::read(_fd, buf, size);
+    } while (n < 0 && errno == EINTR);
+    return static_cast<int>(n);
+}
+
+// 短写时继续写完剩余部分，只有出错才返回 -1
+int PosixFile::write(const char *buf, size_t size)
+{
+    size_t done = 0;
+    while (done < size) {
+        ssize_t n = ::write(_fd, buf + done, size - done);
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return -1;
+        }
+        done += static_cast<size_t>(n);
+    }
+    return static_cast<int>(done);
+}
@@ -0,0 +1,26 @@
+#ifndef __POSIX_FILE_H__
+#define __POSIX_FILE_H__
+
+#include "file.h"
+
+// File 的真实实现，直接调用 POSIX 的 open/read/write/close
+// open 成功返回 0，失败返回 -1，与 Logger::init 的约定一致
+class PosixFile : public File
+{
+public:
+    PosixFile() = default;
+    ~PosixFile() override;
+
+    PosixFile(const PosixFile &) = delete;
+    PosixFile &operator=(const PosixFile &) = delete;
+
+    int open(const char *name) override;
+    int close() override;
+    int read(char *buf, size_t size) override;
+    int write(const char *buf, size_t size) override;
+
+private:
+    int _fd = -1;
+};
+
+#endif
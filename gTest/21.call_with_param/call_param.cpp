@@ -1,5 +1,6 @@
 #include <gtest/gtest.h>
 #include <gmock/gmock.h>
+#include "bench_test.h"
 
 class Calc
 {
@@ -39,3 +40,28 @@ TEST(CalcTest, MockCalcTestCase3) {
 
     UseCalc(calc, -1, 0) ;
 }
+
+class PlainCalc : public Calc
+{
+public:
+    int Do(int a, int b) override { return a + b; }
+};
+
+// 对照：普通虚调用 vs 经过 gmock 匹配的调用
+BENCH_TEST(UseCalcBench, Plain) {
+    PlainCalc calc;
+    int sum = 0;
+    for (auto _ : state) {
+        sum = UseCalc(calc, sum, 1);
+        bench::DoNotOptimize(sum);
+    }
+}
+
+BENCH_TEST(UseCalcBench, Mock) {
+    testing::NiceMock<MockCalc> calc;
+    ON_CALL(calc, Do(testing::Gt(5), testing::Lt(19))).WillByDefault(testing::Return(1));
+    for (auto _ : state) {
+        int r = UseCalc(calc, 6, 9);
+        bench::DoNotOptimize(r);
+    }
+}
@@ -0,0 +1,58 @@
+#include "calc.h"
+#include "concurrent_calc.h"
+#include <gmock/gmock.h>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+// 1 ~ 32 个线程同时调用同一个 mock 的吞吐：gmock 的 MockCalc 与 ConcurrentMockCalc
+// 用法：bench_concurrent_calc [每个线程的调用次数，默认 200000]
+
+using testing::_;
+
+template <typename CalcType>
+static double run(CalcType &calc, int threads, long calls)
+{
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; ++t) {
+        workers.emplace_back([&calc, calls] {
+            long sum = 0;
+            for (long i = 0; i < calls; ++i) {
+                sum += UseCalc(calc, static_cast<int>(i & 1023), 1);
+            }
+            if (sum == 42) {
+                std::printf(" ");
+            }
+        });
+    }
+    for (std::thread &w : workers) {
+        w.join();
+    }
+    double sec = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return threads * calls / sec;
+}
+
+int main(int argc, char **argv)
+{
+    testing::InitGoogleMock(&argc, argv);
+    long calls = argc > 1 ? std::atol(argv[1]) : 200000;
+    std::printf("%8s %18s %18s\n", "threads", "gmock calls/s", "concurrent calls/s");
+    for (int threads = 1; threads <= 32; threads *= 2) {
+        double gmock, concurrent;
+        {
+            MockCalc calc;
+            EXPECT_CALL(calc, Do(testing::Ge(0), _)).Times(testing::AnyNumber()).WillRepeatedly(testing::Return(1));
+            gmock = run(calc, threads, calls / 10);    // gmock 太慢，少跑一些
+        }
+        {
+            ConcurrentMockCalc calc;
+            calc.expect(testing::Ge(0), _).Times(testing::AnyNumber()).WillRepeatedly(1);
+            concurrent = run(calc, threads, calls);
+        }
+        std::printf("%8d %18.0f %18.0f\n", threads, gmock, concurrent);
+    }
+    return 0;
+}
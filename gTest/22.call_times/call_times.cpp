@@ -1,21 +1,10 @@
 #include <gtest/gtest.h>
 #include <gmock/gmock.h>
-
-class Calc
-{
-public:
-    virtual int Do(int a, int b) = 0;
-};
-
-class MockCalc : public Calc
-{
-public:
-    MOCK_METHOD(int, Do, (int a, int b), (override));
-};
-
-int UseCalc(Calc &c, int a, int b) {
-    return c.Do(a, b);
-}
+#include <gtest/gtest-spi.h>
+#include "calc.h"
+#include "concurrent_calc.h"
+#include <thread>
+#include <vector>
 
 using testing::_;
 
@@ -46,3 +35,73 @@ TEST(CalcTest, MockCalcTestCase4) {
     UseCalc(calc, 0, 1);
     UseCalc(calc, 2, 3);
 }
+
+class AddCalc : public Calc
+{
+public:
+    int Do(int a, int b) override { return a + b; }
+};
+
+static void CallFromThreads(Calc &calc, int threads, int callsPerThread)
+{
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; ++t) {
+        workers.emplace_back([&calc, t, callsPerThread] {
+            for (int i = 0; i < callsPerThread; ++i) {
+                UseCalc(calc, t, i);
+            }
+        });
+    }
+    for (std::thread &w : workers) {
+        w.join();
+    }
+}
+
+TEST(ConcurrentCalcTest, CountsAcrossThreads) {
+    ConcurrentMockCalc calc;
+    auto &odd = calc.expect(testing::Truly([](int a) { return a % 2 == 1; }), _).Times(4 * 1000);
+    auto &even = calc.expect(testing::Truly([](int a) { return a % 2 == 0; }), testing::Lt(1000))
+                     .Times(4 * 1000)
+                     .WillRepeatedly(7);
+    CallFromThreads(calc, 8, 1000);
+    EXPECT_EQ(odd.calls(), 4000);
+    EXPECT_EQ(even.calls(), 4000);
+    EXPECT_EQ(UseCalc(calc, 2, 0), 7);
+    EXPECT_NONFATAL_FAILURE(calc.verify(), "Expected: to be called 4000 times");
+}
+
+TEST(ConcurrentCalcTest, NewestRuleWins) {
+    ConcurrentMockCalc calc;
+    calc.expect(_, _).Times(testing::AnyNumber()).WillRepeatedly(1);
+    calc.expect(testing::Gt(5), _).Times(testing::AtLeast(1)).WillRepeatedly(2);
+    EXPECT_EQ(UseCalc(calc, 6, 0), 2);
+    EXPECT_EQ(UseCalc(calc, 5, 0), 1);
+    EXPECT_TRUE(calc.verify());
+}
+
+TEST(ConcurrentCalcTest, ReportsLikeGmock) {
+    EXPECT_NONFATAL_FAILURE({
+        ConcurrentMockCalc calc;
+        calc.expect(testing::Eq(1), _).Times(1);
+        CallFromThreads(calc, 2, 1);
+    }, "Unexpected mock function call - 1 call(s) matched no rule");
+    EXPECT_NONFATAL_FAILURE({
+        ConcurrentMockCalc calc;
+        calc.expect(_, _).Times(testing::Between(1, 3));
+        CallFromThreads(calc, 4, 1);
+    }, "Expected: to be called between 1 and 3 times");
+    EXPECT_NONFATAL_FAILURE({
+        ConcurrentMockCalc calc;
+        calc.expect(testing::Gt(0), _);
+    }, "Actual: called 0 times");
+}
+
+TEST(ConcurrentCalcTest, SpyForwardsToRealCalc) {
+    AddCalc real;
+    ConcurrentMockCalc spy(&real);
+    auto &big = spy.expect(testing::Ge(2), _).Times(2 * 100);
+    CallFromThreads(spy, 4, 100);
+    EXPECT_EQ(UseCalc(spy, 3, 4), 7);
+    EXPECT_EQ(big.calls(), 201);
+    EXPECT_NONFATAL_FAILURE(spy.verify(), "called 201 times");
+}
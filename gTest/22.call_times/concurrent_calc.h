@@ -0,0 +1,221 @@
+#ifndef __CONCURRENT_CALC_H__
+#define __CONCURRENT_CALC_H__
+
+#include "calc.h"
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include <atomic>
+#include <climits>
+#include <cstdint>
+#include <deque>
+#include <sstream>
+#include <string>
+#include <vector>
+
+// 多线程调用的 Calc mock / spy
+//
+// gmock 的每次调用都要拿一把全局锁，多个线程压测同一个 MockCalc 时，测出来的只是这把锁的吞吐
+// 这里的调用路径上没有锁：
+//   - 规则（参数匹配器 + 次数 + 返回值）在调用开始前注册好，之后只读
+//   - 匹配直接调用 gmock 的 Matcher<int>::Matches（Gt/Lt/Eq/_ 等都是无状态的，可以并发调用）
+//   - 每条规则的调用次数记在按线程分片的计数器里，每个分片独占一条缓存行
+//   - verify()（析构时自动调用）把分片加起来，再按 Times() 检查
+//
+//   ConcurrentMockCalc calc;
+//   calc.expect(Gt(0), _).Times(AtLeast(1)).WillRepeatedly(7);
+//
+// 构造时传入真实的 Calc 就成了 spy：没有命中规则、或命中的规则没有返回值时，转发给真实对象，
+// 不命中也不算失败
+class ConcurrentMockCalc : public Calc
+{
+public:
+    static constexpr size_t kShards = 64;
+
+    class Rule
+    {
+    public:
+        Rule &Times(int n) { return Times(::testing::Exactly(n)); }
+
+        Rule &Times(const ::testing::Cardinality &c)
+        {
+            _min = c.ConservativeLowerBound();
+            _max = c.ConservativeUpperBound();
+            return *this;
+        }
+
+        Rule &WillRepeatedly(int value)
+        {
+            _value = value;
+            _hasValue = true;
+            return *this;
+        }
+
+        uint64_t calls() const
+        {
+            uint64_t n = 0;
+            for (const Shard &s : _shards) {
+                n += s.count.load(std::memory_order_relaxed);
+            }
+            return n;
+        }
+
+    private:
+        friend class ConcurrentMockCalc;
+
+        struct alignas(64) Shard
+        {
+            std::atomic<uint64_t> count {0};
+        };
+
+        Rule(::testing::Matcher<int> a, ::testing::Matcher<int> b, const char *file, int line)
+        : _a(a)
+        , _b(b)
+        , _file(file)
+        , _line(line)
+        , _shards(kShards)
+        {}
+
+        ::testing::Matcher<int> _a;
+        ::testing::Matcher<int> _b;
+        const char *_file;
+        int _line;
+        // 没写 Times 时和 gmock 一样：有 WillRepeatedly 为 AnyNumber，否则为 Times(1)
+        int _min = -1;
+        int _max = -1;
+        int _value = 0;
+        bool _hasValue = false;
+        std::vector<Shard> _shards;
+    };
+
+    explicit ConcurrentMockCalc(Calc *delegate = nullptr)
+    : _delegate(delegate)
+    , _unexpected(kShards)
+    {}
+
+    ConcurrentMockCalc(const ConcurrentMockCalc &) = delete;
+    ConcurrentMockCalc &operator=(const ConcurrentMockCalc &) = delete;
+
+    ~ConcurrentMockCalc() override { verify(); }
+
+    // 注册规则，必须在并发调用开始之前完成；多条规则都命中时取最新注册的
+    Rule &expect(::testing::Matcher<int> a, ::testing::Matcher<int> b,
+                 const char *file = __builtin_FILE(), int line = __builtin_LINE())
+    {
+        _rules.push_back(Rule(a, b, file, line));
+        return _rules.back();
+    }
+
+    int Do(int a, int b) override
+    {
+        size_t shard = shardIndex();
+        for (auto it = _rules.rbegin(); it != _rules.rend(); ++it) {
+            Rule &r = *it;
+            if (r._a.Matches(a) && r._b.Matches(b)) {
+                r._shards[shard].count.fetch_add(1, std::memory_order_relaxed);
+                if (r._hasValue || !_delegate) {
+                    return r._value;
+                }
+                return _delegate->Do(a, b);
+            }
+        }
+        if (_delegate) {
+            return _delegate->Do(a, b);
+        }
+        if (_unexpected[shard].count.fetch_add(1, std::memory_order_relaxed) == 0) {
+            // 每个分片只记第一次不匹配的参数，够定位问题
+            _unexpected[shard].a = a;
+            _unexpected[shard].b = b;
+            _unexpected[shard].recorded.store(true, std::memory_order_release);
+        }
+        return 0;
+    }
+
+    uint64_t unexpectedCalls() const
+    {
+        uint64_t n = 0;
+        for (const Unexpected &u : _unexpected) {
+            n += u.count.load(std::memory_order_relaxed);
+        }
+        return n;
+    }
+
+    // 汇总各分片并检查次数；必须在所有调用线程结束之后调用
+    bool verify()
+    {
+        bool ok = true;
+        for (const Rule &r : _rules) {
+            uint64_t n = r.calls();
+            bool defaulted = r._min < 0;
+            int lo = defaulted ? (r._hasValue ? 0 : 1) : r._min;
+            int hi = defaulted ? (r._hasValue ? INT_MAX : 1) : r._max;
+            if (n < static_cast<uint64_t>(lo) || n > static_cast<uint64_t>(hi)) {
+                ok = false;
+                ADD_FAILURE_AT(r._file, r._line)
+                    << "Actual function call count doesn't match EXPECT_CALL(calc, Do("
+                    << describe(r._a) << ", " << describe(r._b) << "))...\n"
+                    << "         Expected: to be called " << describeTimes(lo, hi) << "\n"
+                    << "           Actual: called " << n << " times";
+            }
+        }
+        uint64_t unexpected = unexpectedCalls();
+        if (unexpected > 0) {
+            ok = false;
+            ::testing::Message msg;
+            msg << "Unexpected mock function call - " << unexpected << " call(s) matched no rule";
+            for (const Unexpected &u : _unexpected) {
+                if (u.recorded.load(std::memory_order_acquire)) {
+                    msg << "\n    e.g. Do(" << u.a << ", " << u.b << ")";
+                    break;
+                }
+            }
+            ADD_FAILURE() << msg;
+        }
+        _rules.clear();
+        for (Unexpected &u : _unexpected) {
+            u.count.store(0, std::memory_order_relaxed);
+            u.recorded.store(false, std::memory_order_relaxed);
+        }
+        return ok;
+    }
+
+private:
+    struct alignas(64) Unexpected
+    {
+        std::atomic<uint64_t> count {0};
+        std::atomic<bool> recorded {false};
+        int a = 0;
+        int b = 0;
+    };
+
+    // 每个线程第一次调用时领一个编号，之后一直用同一个分片
+    static size_t shardIndex()
+    {
+        static std::atomic<size_t> next {0};
+        thread_local size_t index = next.fetch_add(1, std::memory_order_relaxed) % kShards;
+        return index;
+    }
+
+    static std::string describe(const ::testing::Matcher<int> &m)
+    {
+        std::ostringstream os;
+        m.DescribeTo(&os);
+        return os.str();
+    }
+
+    static std::string describeTimes(int lo, int hi)
+    {
+        if (lo == hi) {
+            return lo == 1 ? "once" : lo == 2 ? "twice" : std::to_string(lo) + " times";
+        }
+        if (hi == INT_MAX) {
+            return "at least " + std::to_string(lo) + " times";
+        }
+        return "between " + std::to_string(lo) + " and " + std::to_string(hi) + " times";
+    }
+
+    Calc *_delegate;
+    std::deque<Rule> _rules;
+    std::vector<Unexpected> _unexpected;
+};
+
+#endif
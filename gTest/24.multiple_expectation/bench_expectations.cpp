@@ -0,0 +1,71 @@
+#include "calc.h"
+#include "table_mock_calc.h"
+#include <gmock/gmock.h>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+// 回放 n 条 Do(i, _).WillOnce(..).RetiresOnSaturation() 期望：注册 + 按注册顺序各调用一次 + 析构校验
+// gmock 每次调用从最新的期望往前扫，按注册顺序回放时每次都要扫过所有更新的期望，总体 O(n^2)
+// 用法：bench_expectations [最大条数，默认 100000]；gmock 只跑到 20000 条
+
+using testing::_;
+using testing::Return;
+
+static double seconds(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+static double replayGmock(int n)
+{
+    auto start = std::chrono::steady_clock::now();
+    long sum = 0;
+    {
+        MockCalc calc;
+        for (int i = 0; i < n; ++i) {
+            EXPECT_CALL(calc, Do(i, _)).WillOnce(Return(i)).RetiresOnSaturation();
+        }
+        for (int i = 0; i < n; ++i) {
+            sum += UseCalc(calc, i, 0);
+        }
+    }
+    return sum >= 0 ? seconds(start) : 0;
+}
+
+static double replayTable(int n)
+{
+    auto start = std::chrono::steady_clock::now();
+    long sum = 0;
+    {
+        TableMockCalc calc;
+        for (int i = 0; i < n; ++i) {
+            calc.expect(i).WillOnce(i).RetiresOnSaturation();
+        }
+        for (int i = 0; i < n; ++i) {
+            sum += UseCalc(calc, i, 0);
+        }
+    }
+    return sum >= 0 ? seconds(start) : 0;
+}
+
+int main(int argc, char **argv)
+{
+    testing::InitGoogleMock(&argc, argv);
+    int maxN = argc > 1 ? std::atoi(argv[1]) : 100000;
+    std::printf("%8s %14s %14s\n", "n", "gmock (s)", "table (s)");
+    for (int n = 1000; n <= maxN; n *= 10) {
+        for (int m : {n, 2 * n, 5 * n}) {
+            if (m > maxN) {
+                break;
+            }
+            double table = replayTable(m);
+            if (m <= 20000) {
+                std::printf("%8d %14.4f %14.4f\n", m, replayGmock(m), table);
+            } else {
+                std::printf("%8d %14s %14.4f\n", m, "-", table);
+            }
+        }
+    }
+    return 0;
+}
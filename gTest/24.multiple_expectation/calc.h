@@ -0,0 +1,23 @@
+#ifndef __CALC_H__
+#define __CALC_H__
+
+#include <gmock/gmock.h>
+
+class Calc
+{
+public:
+    virtual ~Calc() = default;
+    virtual int Do(int a, int b) = 0;
+};
+
+class MockCalc : public Calc
+{
+public:
+    MOCK_METHOD(int, Do, (int a, int b), (override));
+};
+
+inline int UseCalc(Calc &c, int a, int b) {
+    return c.Do(a, b);
+}
+
+#endif
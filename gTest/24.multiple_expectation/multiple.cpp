@@ -1,22 +1,9 @@
 #include "gmock/gmock.h"
 #include <gtest/gtest.h>
 #include <gmock/gmock.h>
-
-class Calc
-{
-public:
-    virtual int Do(int a, int b) = 0;
-};
-
-class MockCalc : public Calc
-{
-public:
-    MOCK_METHOD(int, Do, (int a, int b), (override));
-};
-
-int UseCalc(Calc &c, int a, int b) {
-    return c.Do(a, b);
-}
+#include <gtest/gtest-spi.h>
+#include "calc.h"
+#include "table_mock_calc.h"
 
 using testing::_;
 using testing::Return;
@@ -65,3 +52,74 @@ TEST(CalcTest, MockCalcTestCase4) {
     EXPECT_EQ(UseCalc(calc, 5, 10), 10);
     EXPECT_EQ(UseCalc(calc, 5, 10), 0);
 }
+
+// 下面是同样的场景换成表驱动的 mock，行为应与上面一致
+TEST(TableMockCalcTest, LikeCase1) {
+    TableMockCalc calc;
+    calc.expectAny().WillOnce(10);
+    calc.expect(5).WillOnce(20);
+    EXPECT_EQ(UseCalc(calc, 6, 10), 10);
+    EXPECT_EQ(UseCalc(calc, 5, 10), 20);
+}
+
+TEST(TableMockCalcTest, LikeCase3) {
+    TableMockCalc calc;
+    for (int i = 0; i < 3; ++i) {
+        calc.expect(i).WillOnce(10 * i);
+    }
+    EXPECT_EQ(UseCalc(calc, 2, 10), 20);
+    EXPECT_EQ(UseCalc(calc, 1, 10), 10);
+    EXPECT_EQ(UseCalc(calc, 0, 10), 0);
+}
+
+TEST(TableMockCalcTest, LikeCase4) {
+    TableMockCalc calc;
+    for (int i = 0; i < 3; ++i) {
+        calc.expectAny().WillOnce(10 * i).RetiresOnSaturation();
+    }
+    EXPECT_EQ(UseCalc(calc, 5, 10), 20);
+    EXPECT_EQ(UseCalc(calc, 5, 10), 10);
+    EXPECT_EQ(UseCalc(calc, 5, 10), 0);
+}
+
+TEST(TableMockCalcTest, RetiredKeyFallsBackToOlderExpectation) {
+    TableMockCalc calc;
+    calc.expect(7).WillRepeatedly(1);                             // 最早的，永远不退休
+    calc.expectAny().Times(2).WillRepeatedly(2).RetiresOnSaturation();
+    calc.expect(7).WillOnce(3).WillOnce(4).RetiresOnSaturation();  // 最新的
+    EXPECT_EQ(UseCalc(calc, 7, 0), 3);
+    EXPECT_EQ(UseCalc(calc, 7, 0), 4);
+    EXPECT_EQ(UseCalc(calc, 7, 0), 2);
+    EXPECT_EQ(UseCalc(calc, 8, 0), 2);
+    EXPECT_EQ(UseCalc(calc, 7, 0), 1);
+    EXPECT_EQ(UseCalc(calc, 7, 0), 1);
+}
+
+TEST(TableMockCalcTest, TimesAndDefaults) {
+    TableMockCalc calc;
+    calc.expect(1).Times(testing::Between(1, 3)).WillOnce(5);
+    calc.expect(2).Times(testing::AnyNumber());
+    EXPECT_EQ(UseCalc(calc, 1, 0), 5);
+    EXPECT_EQ(UseCalc(calc, 1, 0), 0);
+    EXPECT_TRUE(calc.verify());
+}
+
+TEST(TableMockCalcTest, ReportsLikeGmock) {
+    EXPECT_NONFATAL_FAILURE({
+        TableMockCalc calc;
+        calc.expect(1);
+        UseCalc(calc, 2, 0);
+        UseCalc(calc, 1, 0);
+    }, "Unexpected mock function call");
+    EXPECT_NONFATAL_FAILURE({
+        TableMockCalc calc;
+        calc.expect(1).WillOnce(1);
+        UseCalc(calc, 1, 0);
+        UseCalc(calc, 1, 0);
+    }, "called more times than expected");
+    EXPECT_NONFATAL_FAILURE({
+        TableMockCalc calc;
+        calc.expect(1).Times(2);
+        UseCalc(calc, 1, 0);
+    }, "to be called twice");
+}
@@ -0,0 +1,206 @@
+#ifndef __TABLE_MOCK_CALC_H__
+#define __TABLE_MOCK_CALC_H__
+
+#include "calc.h"
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <climits>
+#include <cstdint>
+#include <deque>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// 表驱动的 Calc mock：为从流量录制里生成的大量期望准备
+//
+// gmock 按“从新到旧”扫描所有期望来匹配一次调用，几千条 EXPECT_CALL(calc, Do(i, _)) 时每次调用都是 O(n)
+// 这里只支持 Do(a, _)（第一个参数精确匹配）和 Do(_, _) 两种期望，按第一个参数建哈希索引：
+// 同一个 key 的期望按注册顺序放在一个 vector 里，最新的在末尾；已经退休的期望不会再被匹配，
+// 而它们一定都在末尾（匹配总是选最新的没退休的那条），所以直接弹出，每次调用均摊 O(1)
+//
+//   TableMockCalc calc;
+//   calc.expect(5).WillOnce(20).RetiresOnSaturation();   // 相当于 EXPECT_CALL(calc, Do(5, _))
+//   calc.expectAny().WillRepeatedly(0);                   // 相当于 EXPECT_CALL(calc, Do)
+//
+// 语义与 gmock 保持一致：
+//   - 匹配取最新的、没有退休的期望；饱和后没有 RetiresOnSaturation 的期望仍然会被匹配并报“调用次数过多”
+//   - 没写 Times 时：只有 n 个 WillOnce 为 Times(n)，再加 WillRepeatedly 为 AtLeast(n)，都没有为 Times(1)
+//   - WillOnce 用完后返回 WillRepeatedly 的值，没有则返回 0
+//   - 没有匹配的调用、析构（或 verify()）时次数不满足的期望都记为测试失败
+// 不是线程安全的
+class TableMockCalc : public Calc
+{
+public:
+    class Expectation
+    {
+    public:
+        Expectation &Times(int n) { return Times(::testing::Exactly(n)); }
+
+        Expectation &Times(const ::testing::Cardinality &c)
+        {
+            _min = c.ConservativeLowerBound();
+            _max = c.ConservativeUpperBound();
+            _explicitTimes = true;
+            return *this;
+        }
+
+        Expectation &WillOnce(int value)
+        {
+            _once.push_back(value);
+            return *this;
+        }
+
+        Expectation &WillRepeatedly(int value)
+        {
+            _repeat = value;
+            _hasRepeat = true;
+            return *this;
+        }
+
+        Expectation &RetiresOnSaturation()
+        {
+            _retires = true;
+            return *this;
+        }
+
+        int calls() const { return _calls; }
+        bool retired() const { return _retired; }
+
+    private:
+        friend class TableMockCalc;
+
+        Expectation(bool any, int key, uint64_t seq, const char *file, int line)
+        : _any(any)
+        , _key(key)
+        , _seq(seq)
+        , _file(file)
+        , _line(line)
+        {}
+
+        int minCalls() const
+        {
+            return _explicitTimes ? _min : _once.empty() ? (_hasRepeat ? 0 : 1) : static_cast<int>(_once.size());
+        }
+
+        int maxCalls() const
+        {
+            return _explicitTimes ? _max : _hasRepeat ? INT_MAX : std::max<int>(1, static_cast<int>(_once.size()));
+        }
+
+        bool _any;
+        int _key;
+        uint64_t _seq;
+        const char *_file;
+        int _line;
+        int _min = 0;
+        int _max = 0;
+        bool _explicitTimes = false;
+        std::vector<int> _once;
+        int _repeat = 0;
+        bool _hasRepeat = false;
+        bool _retires = false;
+        bool _retired = false;
+        int _calls = 0;
+    };
+
+    TableMockCalc() = default;
+    TableMockCalc(const TableMockCalc &) = delete;
+    TableMockCalc &operator=(const TableMockCalc &) = delete;
+
+    ~TableMockCalc() override { verify(); }
+
+    // Do(a, _)
+    Expectation &expect(int a, const char *file = __builtin_FILE(), int line = __builtin_LINE())
+    {
+        _all.push_back(Expectation(false, a, _all.size(), file, line));
+        _byKey[a].push_back(&_all.back());
+        return _all.back();
+    }
+
+    // Do(_, _)
+    Expectation &expectAny(const char *file = __builtin_FILE(), int line = __builtin_LINE())
+    {
+        _all.push_back(Expectation(true, 0, _all.size(), file, line));
+        _any.push_back(&_all.back());
+        return _all.back();
+    }
+
+    int Do(int a, int b) override
+    {
+        Expectation *keyed = nullptr;
+        auto it = _byKey.find(a);
+        if (it != _byKey.end()) {
+            keyed = newestActive(it->second);
+        }
+        Expectation *any = newestActive(_any);
+        Expectation *e = !keyed ? any : !any ? keyed : keyed->_seq > any->_seq ? keyed : any;
+        if (!e) {
+            ADD_FAILURE() << "Unexpected mock function call - returning default value.\n"
+                          << "    Function call: Do(" << a << ", " << b << ")\n"
+                          << "          Returns: 0\n"
+                          << "Google Mock tried the following " << _all.size() << " expectations, but none matched";
+            return 0;
+        }
+        int n = e->_calls++;
+        int ret = n < static_cast<int>(e->_once.size()) ? e->_once[n] : e->_hasRepeat ? e->_repeat : 0;
+        if (e->_calls > e->maxCalls()) {
+            ADD_FAILURE_AT(e->_file, e->_line)
+                << "Mock function called more times than expected - returning " << ret << ".\n"
+                << "    Function call: Do(" << a << ", " << b << ")\n"
+                << "         Expected: to be called " << describe(*e) << "\n"
+                << "           Actual: called " << e->_calls << " times - over-saturated and active";
+        }
+        if (e->_retires && e->_calls >= e->maxCalls()) {
+            e->_retired = true;
+        }
+        return ret;
+    }
+
+    // 检查每条期望的调用次数，和 gmock 一样在析构时自动调用
+    bool verify()
+    {
+        bool ok = true;
+        for (const Expectation &e : _all) {
+            if (e._calls < e.minCalls()) {
+                ok = false;
+                ADD_FAILURE_AT(e._file, e._line)
+                    << "Actual function call count doesn't match EXPECT_CALL(calc, Do("
+                    << (e._any ? std::string("_") : std::to_string(e._key)) << ", _))...\n"
+                    << "         Expected: to be called " << describe(e) << "\n"
+                    << "           Actual: called " << e._calls << " times - unsatisfied and active";
+            }
+        }
+        _all.clear();
+        _byKey.clear();
+        _any.clear();
+        return ok;
+    }
+
+private:
+    static Expectation *newestActive(std::vector<Expectation *> &list)
+    {
+        while (!list.empty() && list.back()->_retired) {
+            list.pop_back();
+        }
+        return list.empty() ? nullptr : list.back();
+    }
+
+    static std::string describe(const Expectation &e)
+    {
+        int lo = e.minCalls(), hi = e.maxCalls();
+        if (lo == hi) {
+            return lo == 1 ? "once" : lo == 2 ? "twice" : std::to_string(lo) + " times";
+        }
+        if (hi == INT_MAX) {
+            return "at least " + std::to_string(lo) + " times";
+        }
+        return "between " + std::to_string(lo) + " and " + std::to_string(hi) + " times";
+    }
+
+    std::deque<Expectation> _all;     // deque 保证引用稳定
+    std::unordered_map<int, std::vector<Expectation *>> _byKey;
+    std::vector<Expectation *> _any;
+};
+
+#endif
@@ -0,0 +1,132 @@
+#include "flat_map.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <random>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <vector>
+
+// FlatMap<int, int> 与 std::map<int, int> 对比：
+//   build  从无序的键值对构造（std::map 逐个 insert，FlatMap 排序一次）
+//   lookup 1M 次随机查找（全部命中）
+//   iterate 顺序遍历求和
+// 用法：bench_flat_map [最大元素个数，默认 10000000] [重复次数，默认 3]，从 1000 开始每次 ×10
+//
+// 每次测量都在 fork 出来的子进程里做：上一次测量释放掉的几百 MB 节点不会留在堆里，
+// 影响下一次的分配速度（在同一进程里紧接着大 std::map 之后构造 FlatMap，build 会慢好几倍）
+// 两种容器交替先后、重复多次，每项取最小值
+
+static double seconds(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+static volatile long g_sink;
+
+template <class Map>
+static void lookupAndIterate(const Map &m, const std::vector<int> &probes, double &lookupSec, double &iterSec)
+{
+    auto start = std::chrono::steady_clock::now();
+    long sum = 0;
+    for (int k : probes) {
+        sum += m.find(k)->second;
+    }
+    lookupSec = seconds(start);
+
+    start = std::chrono::steady_clock::now();
+    for (const auto &kv : m) {
+        sum += kv.second;
+    }
+    iterSec = seconds(start);
+    g_sink = sum;
+}
+
+// 在子进程里执行 f(times)，把 3 个时间通过管道带回来
+template <class F>
+static void isolated(double *times, F f)
+{
+    int fd[2];
+    if (pipe(fd) != 0) {
+        std::perror("pipe");
+        std::exit(1);
+    }
+    pid_t pid = fork();
+    if (pid < 0) {
+        std::perror("fork");
+        std::exit(1);
+    }
+    if (pid == 0) {
+        close(fd[0]);
+        double t[3] = {};
+        f(t);
+        bool ok = write(fd[1], t, sizeof(t)) == static_cast<ssize_t>(sizeof(t));
+        _exit(ok ? 0 : 1);
+    }
+    close(fd[1]);
+    bool ok = read(fd[0], times, 3 * sizeof(double)) == static_cast<ssize_t>(3 * sizeof(double));
+    close(fd[0]);
+    int status = 0;
+    waitpid(pid, &status, 0);
+    if (!ok || !WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+        std::fprintf(stderr, "measurement process failed\n");
+        std::exit(1);
+    }
+}
+
+int main(int argc, char **argv)
+{
+    size_t maxN = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10000000;
+    int rounds = argc > 2 ? std::max(1, std::atoi(argv[2])) : 3;
+    const size_t kProbes = 1000000;
+    std::mt19937 rng(1);
+    std::printf("%10s | %10s %10s %10s | %10s %10s %10s\n", "n", "map build", "lookup", "iterate",
+                "flat build", "lookup", "iterate");
+    for (size_t n = 1000; n <= maxN; n *= 10) {
+        std::vector<std::pair<int, int>> input(n);
+        for (size_t i = 0; i < n; ++i) {
+            input[i] = {static_cast<int>(i * 2654435761u), static_cast<int>(i)};
+        }
+        std::vector<int> probes(kProbes);
+        std::uniform_int_distribution<size_t> pick(0, n - 1);
+        for (int &p : probes) {
+            p = input[pick(rng)].first;
+        }
+
+        double mapResult[3], flatResult[3];
+        for (int r = 0; r < rounds; ++r) {
+            double mapTimes[3], flatTimes[3];
+            // 奇数轮先测 FlatMap
+            bool flatFirst = r % 2 == 1;
+            for (int k = 0; k < 2; ++k) {
+                if ((k == 0) != flatFirst) {
+                    isolated(mapTimes, [&](double *t) {
+                        auto start = std::chrono::steady_clock::now();
+                        std::map<int, int> m;
+                        for (const auto &kv : input) {
+                            m.insert(kv);
+                        }
+                        t[0] = seconds(start);
+                        lookupAndIterate(m, probes, t[1], t[2]);
+                    });
+                } else {
+                    isolated(flatTimes, [&](double *t) {
+                        auto start = std::chrono::steady_clock::now();
+                        FlatMap<int, int> m(input);
+                        t[0] = seconds(start);
+                        lookupAndIterate(m, probes, t[1], t[2]);
+                    });
+                }
+            }
+            for (int i = 0; i < 3; ++i) {
+                mapResult[i] = r == 0 ? mapTimes[i] : std::min(mapResult[i], mapTimes[i]);
+                flatResult[i] = r == 0 ? flatTimes[i] : std::min(flatResult[i], flatTimes[i]);
+            }
+        }
+        std::printf("%10zu | %10.4f %10.4f %10.4f | %10.4f %10.4f %10.4f\n", n, mapResult[0], mapResult[1],
+                    mapResult[2], flatResult[0], flatResult[1], flatResult[2]);
+    }
+    return 0;
+}
@@ -0,0 +1,106 @@
+#include "int_hash_map.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+// IntHashMap<int, int> 与 std::map、std::unordered_map 对比，每个规模测：
+//   insert  逐个插入 n 个随机 key（哈希表先 reserve）
+//   hit     1M 次随机查找，全部命中
+//   miss    1M 次随机查找，全部不命中
+//   erase   删掉一半的 key，之后再测一次 hit（IntHashMap 没有墓碑，删完不应变慢）
+// 用法：bench_int_hash_map [最大元素个数，默认 10000000]，从 1000 开始每次 ×10
+
+static double seconds(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+static volatile long g_sink;
+
+struct Result
+{
+    double insert, hit, miss, erase, hitAfterErase;
+};
+
+template <class Map>
+static double lookup(const Map &m, const std::vector<int> &probes)
+{
+    auto start = std::chrono::steady_clock::now();
+    long found = 0;
+    for (int k : probes) {
+        auto it = m.find(k);
+        found += it != m.end() ? it->second : 1;
+    }
+    g_sink = found;
+    return seconds(start);
+}
+
+template <class Map>
+static Result run(Map &m, const std::vector<int> &keys, const std::vector<int> &hits,
+                  const std::vector<int> &misses, const std::vector<int> &survivors)
+{
+    Result r;
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < keys.size(); ++i) {
+        m.insert({keys[i], static_cast<int>(i)});
+    }
+    r.insert = seconds(start);
+    r.hit = lookup(m, hits);
+    r.miss = lookup(m, misses);
+
+    start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < keys.size(); i += 2) {
+        m.erase(keys[i]);
+    }
+    r.erase = seconds(start);
+    r.hitAfterErase = lookup(m, survivors);
+    return r;
+}
+
+static void print(const char *name, size_t n, const Result &r)
+{
+    std::printf("%-14s %10zu %9.4f %9.4f %9.4f %9.4f %9.4f\n", name, n, r.insert, r.hit, r.miss, r.erase,
+                r.hitAfterErase);
+}
+
+int main(int argc, char **argv)
+{
+    size_t maxN = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10000000;
+    const size_t kProbes = 1000000;
+    std::mt19937 rng(1);
+    std::printf("%-14s %10s %9s %9s %9s %9s %9s\n", "", "n", "insert", "hit", "miss", "erase", "hit2");
+    for (size_t n = 1000; n <= maxN; n *= 10) {
+        // 偶数 key 放进表里，奇数 key 用来测不命中
+        std::vector<int> keys(n);
+        for (size_t i = 0; i < n; ++i) {
+            keys[i] = static_cast<int>(i * 2654435761u) & ~1;
+        }
+        std::vector<int> hits(kProbes), misses(kProbes), survivors(kProbes);
+        std::uniform_int_distribution<size_t> pick(0, n - 1);
+        for (size_t i = 0; i < kProbes; ++i) {
+            hits[i] = keys[pick(rng)];
+            misses[i] = keys[pick(rng)] | 1;
+            survivors[i] = keys[pick(rng) | 1];  // 下标为偶数的 key 会被删掉，n 是偶数所以不会越界
+        }
+
+        {
+            std::map<int, int> m;
+            print("std::map", n, run(m, keys, hits, misses, survivors));
+        }
+        {
+            std::unordered_map<int, int> m;
+            m.reserve(n);
+            print("unordered_map", n, run(m, keys, hits, misses, survivors));
+        }
+        {
+            IntHashMap<int, int> m;
+            m.reserve(n);
+            print("IntHashMap", n, run(m, keys, hits, misses, survivors));
+        }
+    }
+    return 0;
+}
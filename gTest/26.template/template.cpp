@@ -1,6 +1,9 @@
 #include <gtest/gtest.h>
 #include <gmock/gmock.h>
 #include <map>
+#include "flat_map.h"
+#include "int_hash_map.h"
+#include "map_matchers.h"
 
 class MakeMap 
 {
@@ -27,3 +30,59 @@ TEST(TestMakeMap, Case1)
     makemap.make1();
     makemap.make2();
 }
+
+// 同样的接口，返回连续存储的 FlatMap，省掉 std::map 每个元素一次的节点分配
+class FlatMakeMap
+{
+public:
+    virtual FlatMap<int, int> make1() = 0;
+    virtual FlatMap<int, int> make2() = 0;
+};
+
+class MockFlatMakeMap : public FlatMakeMap
+{
+public:
+    MOCK_METHOD((FlatMap<int, int>), make1, (), (override));
+
+    using ReturnType = FlatMap<int, int>;
+    MOCK_METHOD(ReturnType, make2, (), (override));
+};
+
+TEST(TestMakeMap, FlatCase)
+{
+    MockFlatMakeMap makemap;
+    EXPECT_CALL(makemap, make1)
+        .WillOnce(testing::Return(FlatMap<int, int>({{2, 20}, {1, 10}})));
+    EXPECT_CALL(makemap, make2);
+
+    FlatMap<int, int> m = makemap.make1();
+    EXPECT_EQ(m.size(), 2);
+    EXPECT_EQ(m.begin()->first, 1);
+    EXPECT_EQ(m.at(2), 20);
+    EXPECT_TRUE(makemap.make2().empty());
+}
+
+// 只做点查的场景用哈希表，不需要有序
+class HashMakeMap
+{
+public:
+    virtual IntHashMap<int, int> make1() = 0;
+};
+
+class MockHashMakeMap : public HashMakeMap
+{
+public:
+    MOCK_METHOD((IntHashMap<int, int>), make1, (), (override));
+};
+
+TEST(TestMakeMap, HashCase)
+{
+    MockHashMakeMap makemap;
+    EXPECT_CALL(makemap, make1)
+        .WillOnce(testing::Return(IntHashMap<int, int>({{1, 10}, {2, 20}})));
+
+    IntHashMap<int, int> m = makemap.make1();
+    EXPECT_THAT(m, ContainsKey(1));
+    EXPECT_THAT(m, ContainsEntry(2, testing::Gt(15)));
+    EXPECT_THAT(m, testing::Not(ContainsKey(3)));
+}
@@ -1,6 +1,7 @@
 #include <gtest/gtest.h>
 #include <gmock/gmock.h>
 #include <map>
+#include "flat_map.h"
 
 class MakeMap 
 {
@@ -27,3 +28,31 @@ TEST(TestMakeMap, Case1)
     makemap.make1();
     makemap.make2();
 }
+
+// 同样的私有接口，返回连续存储的 FlatMap
+class FlatMakeMap
+{
+private:
+    virtual FlatMap<int, int> make1() = 0;
+    virtual FlatMap<int, int> make2() = 0;
+};
+
+class MockFlatMakeMap : public FlatMakeMap
+{
+public:
+    MOCK_METHOD((FlatMap<int, int>), make1, (), (override));
+
+    using ReturnType = FlatMap<int, int>;
+    MOCK_METHOD(ReturnType, make2, (), (override));
+};
+
+TEST(TestMakeMap, FlatCase)
+{
+    MockFlatMakeMap makemap;
+    EXPECT_CALL(makemap, make1)
+        .WillOnce(testing::Return(FlatMap<int, int>({{3, 30}, {1, 10}})));
+    EXPECT_CALL(makemap, make2);
+
+    EXPECT_EQ(makemap.make1().find(3)->second, 30);
+    EXPECT_TRUE(makemap.make2().empty());
+}
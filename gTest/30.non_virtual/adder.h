@@ -0,0 +1,17 @@
+#ifndef __ADDER_H__
+#define __ADDER_H__
+
+class Adder 
+{
+public:
+    int add(int a, int b) {
+        return a + b;
+    }
+};
+
+template <typename AdderType>
+int UseAdder(AdderType &adder, int a, int b) {
+    return adder.add(a, b);
+}
+
+#endif
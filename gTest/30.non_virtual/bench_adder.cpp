@@ -0,0 +1,51 @@
+#include <gmock/gmock.h>
+#include "adder.h"
+#include "static_mock.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+// 通过 UseAdder 调用 N 次（默认 10M）：真实的 Adder、静态 mock、gmock 的 MockAdder
+// 用法：bench_adder [调用次数]
+
+class MockAdder
+{
+public:
+    MOCK_METHOD(int, add, (int a, int b), ());
+};
+
+class StaticMockAdder
+{
+public:
+    STATIC_MOCK_METHOD(int, add, (int, int))
+};
+
+template <typename AdderType>
+static void run(const char *name, AdderType &adder, long n)
+{
+    auto start = std::chrono::steady_clock::now();
+    long sum = 0;
+    for (long i = 0; i < n; ++i) {
+        sum += UseAdder(adder, static_cast<int>(i), 1);
+    }
+    double sec = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::printf("%-16s %10ld calls  %8.3f s  %8.2f ns/call  (sum %ld)\n", name, n, sec, sec * 1e9 / n, sum);
+}
+
+int main(int argc, char **argv)
+{
+    long n = argc > 1 ? std::atol(argv[1]) : 10000000;
+
+    Adder adder;
+    run("Adder", adder, n);
+
+    StaticMockAdder staticMock;
+    staticMock.mock_add.returns({1});
+    run("StaticMockAdder", staticMock, n);
+    std::printf("%-16s recorded %zu calls\n", "", staticMock.mock_add.calls());
+
+    testing::NiceMock<MockAdder> mock;
+    ON_CALL(mock, add).WillByDefault(testing::Return(1));
+    run("MockAdder", mock, n);
+    return 0;
+}
@@ -1,13 +1,8 @@
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
-
-class Adder 
-{
-public:
-    int add(int a, int b) {
-        return a + b;
-    }
-};
+#include <string>
+#include "adder.h"
+#include "static_mock.h"
 
 class MockAdder // 没有继承
 {
@@ -15,11 +10,6 @@ public:
     MOCK_METHOD(int, add, (int a, int b), ()); // 没有override
 };
 
-template <typename AdderType>
-int UseAdder(AdderType &adder, int a, int b) {
-    return adder.add(a, b);
-}
-
 using testing::Return;
 TEST(TestAdder, Case) {
     MockAdder adder;
@@ -28,3 +18,63 @@ TEST(TestAdder, Case) {
 
     EXPECT_EQ(UseAdder(adder, 4, 1), 10);
 }
+
+class StaticMockAdder // 没有继承，也没有 gmock
+{
+public:
+    STATIC_MOCK_METHOD(int, add, (int, int))
+};
+
+TEST(TestAdder, StaticMock) {
+    StaticMockAdder adder;
+    adder.mock_add.returns({10});
+
+    EXPECT_EQ(UseAdder(adder, 4, 1), 10);
+    EXPECT_EQ(adder.mock_add.calls(), 1);
+    EXPECT_EQ(adder.mock_add.lastArgs(), std::make_tuple(4, 1));
+}
+
+TEST(TestAdder, StaticMockReturnSequence) {
+    StaticMockAdder adder;
+    adder.mock_add.returns({1, 2, 3});
+
+    EXPECT_EQ(UseAdder(adder, 0, 0), 1);
+    EXPECT_EQ(UseAdder(adder, 0, 0), 2);
+    EXPECT_EQ(UseAdder(adder, 7, 8), 3);
+    EXPECT_EQ(UseAdder(adder, 9, 9), 3); // 用完后重复最后一个
+    EXPECT_EQ(adder.mock_add.calls(), 4);
+    EXPECT_EQ(adder.mock_add.lastArgs(), std::make_tuple(9, 9));
+
+    adder.mock_add.reset();
+    EXPECT_EQ(UseAdder(adder, 1, 1), 0); // 没有设置返回值时返回默认值
+    EXPECT_EQ(adder.mock_add.calls(), 1);
+}
+
+TEST(TestAdder, StaticMockVoid) {
+    StaticMockFunction<void(const char *, int)> log;
+    log("a", 1);
+    log("b", 2);
+    EXPECT_EQ(log.calls(), 2);
+    EXPECT_STREQ(std::get<0>(log.lastArgs()), "b");
+    EXPECT_EQ(std::get<1>(log.lastArgs()), 2);
+}
+
+class StaticMockNamer
+{
+public:
+    STATIC_MOCK_METHOD(int, length, (const std::string &))
+};
+
+TEST(TestAdder, StaticMockReferenceParam) {
+    StaticMockNamer namer;
+    namer.mock_length.returns({5});
+    {
+        std::string name = "hello";
+        EXPECT_EQ(namer.length(name), 5);
+    }
+    // 记录的是副本，原来的字符串销毁之后还能读
+    EXPECT_EQ(std::get<0>(namer.mock_length.lastArgs()), "hello");
+
+    namer.mock_length.reset();
+    EXPECT_EQ(std::get<0>(namer.mock_length.lastArgs()), "");
+}
@@ -0,0 +1,89 @@
+#ifndef __STATIC_MOCK_H__
+#define __STATIC_MOCK_H__
+
+#include <cstddef>
+#include <initializer_list>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// 轻量的静态 mock，用于模板注入的接缝（比如 UseAdder<AdderType>）
+// MOCK_METHOD 每次调用都要加锁、在期望列表里动态查找；这里只在普通成员里记录
+// 调用次数和最后一次的参数，按固定序列返回，调用开销接近直接调用
+// 不是线程安全的，也不做任何期望检查，断言在测试里对 calls() / lastArgs() 做
+// 参数按 decay 之后的类型保存副本，const std::string & 这样的引用参数也能记录
+template <class Signature>
+class StaticMockFunction;
+
+template <class Ret, class... Args>
+class StaticMockFunction<Ret(Args...)>
+{
+public:
+    using ArgsTuple = std::tuple<typename std::decay<Args>::type...>;
+
+    Ret operator()(Args... args)
+    {
+        ++_calls;
+        _last = ArgsTuple(args...);
+        if (_returns.empty()) {
+            return Ret();
+        }
+        // 序列用完后一直返回最后一个值
+        return _returns[_calls <= _returns.size() ? _calls - 1 : _returns.size() - 1];
+    }
+
+    void returns(std::initializer_list<Ret> values) { _returns.assign(values); }
+
+    size_t calls() const { return _calls; }
+    const ArgsTuple &lastArgs() const { return _last; }
+
+    void reset()
+    {
+        _calls = 0;
+        _last = ArgsTuple();
+        _returns.clear();
+    }
+
+private:
+    size_t _calls = 0;
+    ArgsTuple _last {};
+    std::vector<Ret> _returns;
+};
+
+template <class... Args>
+class StaticMockFunction<void(Args...)>
+{
+public:
+    using ArgsTuple = std::tuple<typename std::decay<Args>::type...>;
+
+    void operator()(Args... args)
+    {
+        ++_calls;
+        _last = ArgsTuple(args...);
+    }
+
+    size_t calls() const { return _calls; }
+    const ArgsTuple &lastArgs() const { return _last; }
+
+    void reset()
+    {
+        _calls = 0;
+        _last = ArgsTuple();
+    }
+
+private:
+    size_t _calls = 0;
+    ArgsTuple _last {};
+};
+
+// STATIC_MOCK_METHOD(int, add, (int, int)) 生成成员 mock_add 和转发给它的 add()
+#define STATIC_MOCK_METHOD(Ret, Name, Params)                        \
+    StaticMockFunction<Ret Params> mock_##Name;                      \
+    template <class... A>                                            \
+    Ret Name(A &&...args)                                            \
+    {                                                                \
+        return mock_##Name(std::forward<A>(args)...);                \
+    }
+
+#endif
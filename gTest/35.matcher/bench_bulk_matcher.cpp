@@ -0,0 +1,93 @@
+#include "bulk_matcher.h"
+#include <gmock/gmock.h>
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+// 对 n 个随机数求匹配的个数和第一个匹配的位置：
+//   Matches   std::count_if / std::find_if + testing::Matches，用直接写的 gmock matcher（每个元素走一次虚函数）
+//   mask      bulk::Filter::mask 之后 popcount
+//   findFirst bulk::Filter::findFirst
+// 第一个匹配放在数组的最后，find_if 和 findFirst 都要扫完整个数组
+// 用法：bench_bulk_matcher [元素个数，默认 10000000]
+
+static double seconds(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+template <class T>
+static void bench(const char *name, const testing::Matcher<T> &m, const bulk::Expr<T> &expr,
+                  const std::vector<T> &data)
+{
+    bulk::Filter<T> f(expr);
+
+    auto start = std::chrono::steady_clock::now();
+    size_t gmockCount = std::count_if(data.begin(), data.end(), testing::Matches(m));
+    double gmockCountSec = seconds(start);
+
+    start = std::chrono::steady_clock::now();
+    size_t gmockFirst = std::find_if(data.begin(), data.end(), testing::Matches(m)) - data.begin();
+    double gmockFindSec = seconds(start);
+
+    std::vector<uint64_t> mask((data.size() + 63) / 64);
+    start = std::chrono::steady_clock::now();
+    f.mask(data.data(), data.size(), mask.data());
+    size_t bulkCount = 0;
+    for (uint64_t w : mask) {
+        bulkCount += __builtin_popcountll(w);
+    }
+    double bulkCountSec = seconds(start);
+
+    start = std::chrono::steady_clock::now();
+    size_t bulkFirst = f.findFirst(data);
+    double bulkFindSec = seconds(start);
+
+    if (gmockCount != bulkCount || gmockFirst != bulkFirst) {
+        std::printf("%s: mismatch %zu/%zu %zu/%zu\n", name, gmockCount, bulkCount, gmockFirst, bulkFirst);
+        std::exit(1);
+    }
+    std::printf("%-28s %10.4f %10.4f %10.4f %10.4f %10zu\n", name, gmockCountSec, bulkCountSec, gmockFindSec,
+                bulkFindSec, bulkCount);
+}
+
+int main(int argc, char **argv)
+{
+    size_t n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10000000;
+    std::mt19937 rng(1);
+
+    // 值都在 [0, 100) 里，最后一个元素是唯一大于 1000 的
+    std::vector<int> ints(n);
+    for (int &x : ints) {
+        x = static_cast<int>(rng() % 100);
+    }
+    ints.back() = 5000;
+    std::vector<double> doubles(n);
+    std::uniform_real_distribution<double> value(0, 100);
+    for (double &x : doubles) {
+        x = value(rng);
+    }
+    doubles.back() = 5000;
+
+    std::printf("%-28s %10s %10s %10s %10s %10s\n", "", "Matches", "mask", "find_if", "findFirst", "count");
+    using testing::AllOf;
+    using testing::AnyOf;
+    using testing::Eq;
+    using testing::Ge;
+    using testing::Gt;
+    using testing::Le;
+    using testing::Lt;
+    using testing::Not;
+    bench<int>("int Gt(1000)", Gt(1000), bulk::Gt(1000), ints);
+    bench<int>("int AllOf(Gt(3), Lt(6))", AllOf(Gt(3), Lt(6)), bulk::AllOf(bulk::Gt(3), bulk::Lt(6)), ints);
+    bench<int>("int Not(AnyOf(3 ranges))", Not(AnyOf(Lt(10), AllOf(Ge(40), Le(60)), Gt(90))),
+               bulk::Not(bulk::AnyOf(bulk::Lt(10), bulk::AllOf(bulk::Ge(40), bulk::Le(60)), bulk::Gt(90))), ints);
+    bench<double>("double Gt(1000.0)", Gt(1000.0), bulk::Gt(1000.0), doubles);
+    bench<double>("double AllOf(Gt(3), Lt(6))", AllOf(Gt(3.0), Lt(6.0)), bulk::AllOf(bulk::Gt(3.0), bulk::Lt(6.0)),
+                  doubles);
+    bench<double>("double Not(Eq(50.0))", Not(Eq(50.0)), bulk::Not(bulk::Eq(50.0)), doubles);
+    return 0;
+}
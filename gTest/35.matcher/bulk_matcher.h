@@ -0,0 +1,467 @@
+#ifndef __BULK_MATCHER_H__
+#define __BULK_MATCHER_H__
+
+#include <gmock/gmock.h>
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+// 批量求值的算术 matcher
+//
+// std::find_if(data.begin(), data.end(), Matches(AllOf(Gt(3), Lt(6)))) 每个元素都要经过 Matcher 的虚函数，
+// AllOf 的每个子 matcher 还要再来一次。这里用 bulk::Gt / Lt / Ge / Le / Eq / Ne / AllOf / AnyOf / Not
+// 搭出同样的树，它可以直接转换成 testing::Matcher<T>（给 EXPECT_CALL、Matches 用），
+// 也可以编译成 bulk::Filter<T>：整棵树化简成若干个互不相交的闭区间（浮点数再加一个“是否匹配 NaN”），
+// 对连续数组逐段判断，int 和 double 用 SSE2 一次判断 4 个 / 2 个
+//
+//   bulk::Filter<int> f(bulk::AllOf(bulk::Gt(3), bulk::Lt(6)));
+//   size_t i = f.findFirst(data.data(), data.size());      // 没有匹配时返回 size
+//   std::vector<uint64_t> mask = f.mask(data);             // 第 i 个元素对应第 i / 64 个字的第 i % 64 位
+//
+// 结果和 testing::Matches 逐个元素一致，包括 NaN、±0、±inf 和整数的边界值
+// 比较值的类型就是元素类型：过滤 double 要写 bulk::Gt(4.0)
+namespace bulk
+{
+
+enum class Op
+{
+    Gt,
+    Lt,
+    Ge,
+    Le,
+    Eq,
+    Ne,
+    AllOf,
+    AnyOf,
+    Not,
+};
+
+template <class T>
+class Expr
+{
+public:
+    static_assert(std::is_arithmetic<T>::value, "bulk matchers only support arithmetic types");
+
+    Expr(Op op, T value)
+    : _op(op)
+    , _value(value)
+    {}
+
+    Expr(Op op, std::vector<Expr> children)
+    : _op(op)
+    , _value()
+    , _children(std::move(children))
+    {}
+
+    Op op() const { return _op; }
+    const T &value() const { return _value; }
+    const std::vector<Expr> &children() const { return _children; }
+
+    // 等价的 gmock matcher，描述信息也和直接写 gmock 的一样
+    operator ::testing::Matcher<T>() const
+    {
+        switch (_op) {
+        case Op::Gt:
+            return ::testing::Gt(_value);
+        case Op::Lt:
+            return ::testing::Lt(_value);
+        case Op::Ge:
+            return ::testing::Ge(_value);
+        case Op::Le:
+            return ::testing::Le(_value);
+        case Op::Eq:
+            return ::testing::Eq(_value);
+        case Op::Ne:
+            return ::testing::Ne(_value);
+        case Op::Not:
+            return ::testing::Not(static_cast<::testing::Matcher<T>>(_children[0]));
+        case Op::AllOf:
+        case Op::AnyOf:
+            break;
+        }
+        std::vector<::testing::Matcher<T>> children(_children.begin(), _children.end());
+        if (_op == Op::AllOf) {
+            return ::testing::AllOfArray(children);
+        }
+        return ::testing::AnyOfArray(children);
+    }
+
+private:
+    Op _op;
+    T _value;
+    std::vector<Expr> _children;
+};
+
+template <class T>
+Expr<T> Gt(T value) { return Expr<T>(Op::Gt, value); }
+template <class T>
+Expr<T> Lt(T value) { return Expr<T>(Op::Lt, value); }
+template <class T>
+Expr<T> Ge(T value) { return Expr<T>(Op::Ge, value); }
+template <class T>
+Expr<T> Le(T value) { return Expr<T>(Op::Le, value); }
+template <class T>
+Expr<T> Eq(T value) { return Expr<T>(Op::Eq, value); }
+template <class T>
+Expr<T> Ne(T value) { return Expr<T>(Op::Ne, value); }
+
+template <class T>
+Expr<T> Not(Expr<T> e)
+{
+    return Expr<T>(Op::Not, std::vector<Expr<T>> {std::move(e)});
+}
+
+template <class T, class... Rest>
+Expr<T> AllOf(Expr<T> first, Rest... rest)
+{
+    return Expr<T>(Op::AllOf, std::vector<Expr<T>> {std::move(first), std::move(rest)...});
+}
+
+template <class T, class... Rest>
+Expr<T> AnyOf(Expr<T> first, Rest... rest)
+{
+    return Expr<T>(Op::AnyOf, std::vector<Expr<T>> {std::move(first), std::move(rest)...});
+}
+
+// 一棵树化简后的结果：按顺序排好、互不相交也不相邻的闭区间，外加 NaN 是否匹配
+template <class T>
+class RangeSet
+{
+public:
+    using Range = std::pair<T, T>;
+
+    static RangeSet none() { return RangeSet(); }
+
+    static RangeSet all()
+    {
+        RangeSet s;
+        s._ranges.push_back({lowest(), highest()});
+        s._nan = true;
+        return s;
+    }
+
+    static RangeSet of(const Expr<T> &e)
+    {
+        const T v = e.value();
+        switch (e.op()) {
+        case Op::Gt:
+            return isNan(v) || v == highest() ? none() : range(next(v), highest());
+        case Op::Ge:
+            return isNan(v) ? none() : range(v, highest());
+        case Op::Lt:
+            return isNan(v) || v == lowest() ? none() : range(lowest(), prev(v));
+        case Op::Le:
+            return isNan(v) ? none() : range(lowest(), v);
+        case Op::Eq:
+            return isNan(v) ? none() : range(v, v);
+        case Op::Ne:
+            return (isNan(v) ? none() : range(v, v)).complement();
+        case Op::Not:
+            return of(e.children()[0]).complement();
+        case Op::AllOf: {
+            RangeSet s = all();
+            for (const Expr<T> &child : e.children()) {
+                s = s.intersect(of(child));
+            }
+            return s;
+        }
+        case Op::AnyOf: {
+            RangeSet s = none();
+            for (const Expr<T> &child : e.children()) {
+                s = s.unite(of(child));
+            }
+            return s;
+        }
+        }
+        return none();
+    }
+
+    const std::vector<Range> &ranges() const { return _ranges; }
+    bool matchesNan() const { return _nan; }
+
+    RangeSet complement() const
+    {
+        RangeSet s;
+        s._nan = !_nan;
+        T from = lowest();
+        bool open = true;  // from 是否还是一个有效的起点
+        for (const Range &r : _ranges) {
+            if (r.first != lowest()) {
+                s._ranges.push_back({from, prev(r.first)});
+            }
+            if (r.second == highest()) {
+                open = false;
+                break;
+            }
+            from = next(r.second);
+        }
+        if (open) {
+            s._ranges.push_back({from, highest()});
+        }
+        return s;
+    }
+
+    RangeSet intersect(const RangeSet &other) const
+    {
+        RangeSet s;
+        s._nan = _nan && other._nan;
+        size_t i = 0, j = 0;
+        while (i < _ranges.size() && j < other._ranges.size()) {
+            const Range &a = _ranges[i];
+            const Range &b = other._ranges[j];
+            T lo = a.first < b.first ? b.first : a.first;
+            T hi = a.second < b.second ? a.second : b.second;
+            if (!(hi < lo)) {
+                s._ranges.push_back({lo, hi});
+            }
+            if (a.second < b.second) {
+                ++i;
+            } else {
+                ++j;
+            }
+        }
+        return s;
+    }
+
+    RangeSet unite(const RangeSet &other) const
+    {
+        std::vector<Range> all(_ranges);
+        all.insert(all.end(), other._ranges.begin(), other._ranges.end());
+        std::sort(all.begin(), all.end(), [](const Range &a, const Range &b) { return a.first < b.first; });
+        RangeSet s;
+        s._nan = _nan || other._nan;
+        for (const Range &r : all) {
+            // 重叠或者首尾相邻的区间合并成一个
+            if (!s._ranges.empty() &&
+                (s._ranges.back().second == highest() || !(next(s._ranges.back().second) < r.first))) {
+                if (s._ranges.back().second < r.second) {
+                    s._ranges.back().second = r.second;
+                }
+            } else {
+                s._ranges.push_back(r);
+            }
+        }
+        return s;
+    }
+
+private:
+    static RangeSet range(T lo, T hi)
+    {
+        RangeSet s;
+        s._ranges.push_back({lo, hi});
+        return s;
+    }
+
+    // 整数用 min / max，浮点数用 ±inf，这样 ±inf 本身也在区间里
+    static T lowest()
+    {
+        return std::numeric_limits<T>::has_infinity ? -std::numeric_limits<T>::infinity()
+                                                    : std::numeric_limits<T>::lowest();
+    }
+
+    static T highest()
+    {
+        return std::numeric_limits<T>::has_infinity ? std::numeric_limits<T>::infinity()
+                                                    : std::numeric_limits<T>::max();
+    }
+
+    template <class U = T>
+    static typename std::enable_if<std::is_floating_point<U>::value, bool>::type isNan(U v)
+    {
+        return std::isnan(v);
+    }
+
+    template <class U = T>
+    static typename std::enable_if<!std::is_floating_point<U>::value, bool>::type isNan(U)
+    {
+        return false;
+    }
+
+    // 比 v 大的最小值 / 比 v 小的最大值，调用方保证 v 不是 highest() / lowest()
+    template <class U = T>
+    static typename std::enable_if<std::is_floating_point<U>::value, U>::type next(U v)
+    {
+        return std::nextafter(v, highest());
+    }
+
+    template <class U = T>
+    static typename std::enable_if<!std::is_floating_point<U>::value, U>::type next(U v)
+    {
+        return static_cast<U>(v + 1);
+    }
+
+    template <class U = T>
+    static typename std::enable_if<std::is_floating_point<U>::value, U>::type prev(U v)
+    {
+        return std::nextafter(v, lowest());
+    }
+
+    template <class U = T>
+    static typename std::enable_if<!std::is_floating_point<U>::value, U>::type prev(U v)
+    {
+        return static_cast<U>(v - 1);
+    }
+
+    std::vector<Range> _ranges;
+    bool _nan = false;
+};
+
+template <class T>
+class Filter
+{
+public:
+    explicit Filter(const Expr<T> &e)
+    : _set(RangeSet<T>::of(e))
+    {
+        for (const auto &r : _set.ranges()) {
+            _lo.push_back(r.first);
+            _hi.push_back(r.second);
+        }
+    }
+
+    const RangeSet<T> &ranges() const { return _set; }
+
+    bool matches(T x) const
+    {
+        if (isNan(x)) {
+            return _set.matchesNan();
+        }
+        for (size_t i = 0; i < _lo.size(); ++i) {
+            if (!(x < _lo[i]) && !(_hi[i] < x)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // out 至少要有 (n + 63) / 64 个字
+    void mask(const T *data, size_t n, uint64_t *out) const
+    {
+        size_t words = n / 64;
+        for (size_t w = 0; w < words; ++w) {
+            out[w] = maskWord(data + w * 64);
+        }
+        if (n % 64) {
+            out[words] = maskTail(data + words * 64, n % 64);
+        }
+    }
+
+    std::vector<uint64_t> mask(const std::vector<T> &data) const
+    {
+        std::vector<uint64_t> out((data.size() + 63) / 64);
+        mask(data.data(), data.size(), out.data());
+        return out;
+    }
+
+    // 第一个匹配的下标，没有时返回 n
+    size_t findFirst(const T *data, size_t n) const
+    {
+        size_t words = n / 64;
+        for (size_t w = 0; w < words; ++w) {
+            uint64_t bits = maskWord(data + w * 64);
+            if (bits) {
+                return w * 64 + __builtin_ctzll(bits);
+            }
+        }
+        uint64_t bits = n % 64 ? maskTail(data + words * 64, n % 64) : 0;
+        return bits ? words * 64 + __builtin_ctzll(bits) : n;
+    }
+
+    size_t findFirst(const std::vector<T> &data) const { return findFirst(data.data(), data.size()); }
+
+private:
+    template <class U = T>
+    static typename std::enable_if<std::is_floating_point<U>::value, bool>::type isNan(U v)
+    {
+        return std::isnan(v);
+    }
+
+    template <class U = T>
+    static typename std::enable_if<!std::is_floating_point<U>::value, bool>::type isNan(U)
+    {
+        return false;
+    }
+
+    uint64_t maskTail(const T *p, size_t n) const
+    {
+        uint64_t bits = 0;
+        for (size_t i = 0; i < n; ++i) {
+            bits |= static_cast<uint64_t>(matches(p[i])) << i;
+        }
+        return bits;
+    }
+
+    // 连续 64 个元素的结果；没有 SIMD 实现的类型逐个判断
+    template <class U = T>
+    typename std::enable_if<!std::is_same<U, int>::value && !std::is_same<U, double>::value, uint64_t>::type
+    maskWord(const U *p) const
+    {
+        return maskTail(p, 64);
+    }
+
+#ifdef __SSE2__
+    // x 落在 [lo, hi] 里等价于无符号的 x - lo <= hi - lo，每个区间一次减法一次比较
+    template <class U = T>
+    typename std::enable_if<std::is_same<U, int>::value, uint64_t>::type maskWord(const U *p) const
+    {
+        const __m128i sign = _mm_set1_epi32(static_cast<int>(0x80000000u));
+        uint64_t bits = 0;
+        for (int i = 0; i < 64; i += 4) {
+            __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p + i));
+            // 所有区间都不在里面的通道
+            __m128i out = _mm_set1_epi32(-1);
+            for (size_t r = 0; r < _lo.size(); ++r) {
+                __m128i d = _mm_sub_epi32(x, _mm_set1_epi32(_lo[r]));
+                uint32_t width = static_cast<uint32_t>(_hi[r]) - static_cast<uint32_t>(_lo[r]);
+                // SSE2 只有有符号比较：两边翻转符号位
+                __m128i gt = _mm_cmpgt_epi32(_mm_xor_si128(d, sign),
+                                             _mm_set1_epi32(static_cast<int>(width ^ 0x80000000u)));
+                out = _mm_and_si128(out, gt);
+            }
+            uint32_t in = ~static_cast<uint32_t>(_mm_movemask_ps(_mm_castsi128_ps(out))) & 0xF;
+            bits |= static_cast<uint64_t>(in) << i;
+        }
+        return bits;
+    }
+
+    template <class U = T>
+    typename std::enable_if<std::is_same<U, double>::value, uint64_t>::type maskWord(const U *p) const
+    {
+        uint64_t bits = 0;
+        for (int i = 0; i < 64; i += 2) {
+            __m128d x = _mm_loadu_pd(p + i);
+            // NaN 和任何数比较都是 false，只能由 _nan 决定
+            __m128d in = _set.matchesNan() ? _mm_cmpunord_pd(x, x) : _mm_setzero_pd();
+            for (size_t r = 0; r < _lo.size(); ++r) {
+                in = _mm_or_pd(in, _mm_and_pd(_mm_cmpge_pd(x, _mm_set1_pd(_lo[r])),
+                                              _mm_cmple_pd(x, _mm_set1_pd(_hi[r]))));
+            }
+            bits |= static_cast<uint64_t>(_mm_movemask_pd(in)) << i;
+        }
+        return bits;
+    }
+#else
+    template <class U = T>
+    typename std::enable_if<std::is_same<U, int>::value || std::is_same<U, double>::value, uint64_t>::type
+    maskWord(const U *p) const
+    {
+        return maskTail(p, 64);
+    }
+#endif
+
+    RangeSet<T> _set;
+    std::vector<T> _lo;
+    std::vector<T> _hi;
+};
+
+}  // namespace bulk
+
+#endif
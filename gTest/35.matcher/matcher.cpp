@@ -3,6 +3,11 @@
 #include <gmock/gmock.h>
 #include <gtest/gtest-matchers.h>
 #include <gmock/gmock-matchers.h>
+#include <cmath>
+#include <climits>
+#include <limits>
+#include <random>
+#include "bulk_matcher.h"
 
 class Calc
 {
@@ -59,3 +64,105 @@ TEST(TestMatcher, Case)
     auto t = std::find_if(data.begin(), data.end(), Matches(Gt(4)));
     EXPECT_EQ(*t, 5);
 }
+
+TEST(TestMatcher, BulkCase)
+{
+    std::vector<int> data {1, 2, 3, 4, 5, 6};
+    bulk::Filter<int> gt4(bulk::Gt(4));
+    EXPECT_EQ(data[gt4.findFirst(data)], 5);
+
+    bulk::Filter<int> between(bulk::AllOf(bulk::Gt(3), bulk::Lt(6)));
+    EXPECT_EQ(between.mask(data), std::vector<uint64_t> {0x18});
+    EXPECT_EQ(bulk::Filter<int>(bulk::Gt(6)).findFirst(data), data.size());
+}
+
+// bulk 的表达式也能直接当 gmock matcher 用
+TEST(TestMatcher, BulkExprAsMatcher)
+{
+    MockCalc calc;
+    EXPECT_CALL(calc, add(_, _))
+        .WillRepeatedly(Return(100));
+    EXPECT_CALL(calc, add(bulk::AllOf(bulk::Gt(3), bulk::Lt(6)), _))
+        .WillRepeatedly(Return(10));
+
+    EXPECT_EQ(calc.add(5, 6), 10);
+    EXPECT_EQ(calc.add(0, 6), 100);
+
+    testing::Matcher<int> m = bulk::AnyOf(bulk::Eq(1), bulk::Not(bulk::Le(5)));
+    EXPECT_EQ(testing::DescribeMatcher<int>(m), "(is equal to 1) or (isn't <= 5)");
+}
+
+// 和 testing::Matches 逐个元素对照
+template <class T>
+static void ExpectSameAsGmock(const bulk::Expr<T> &e, const std::vector<T> &data)
+{
+    testing::Matcher<T> m = e;
+    bulk::Filter<T> f(e);
+    std::vector<uint64_t> mask = f.mask(data);
+    size_t first = data.size();
+    for (size_t i = 0; i < data.size(); ++i) {
+        bool expected = m.Matches(data[i]);
+        ASSERT_EQ(((mask[i / 64] >> (i % 64)) & 1) != 0, expected)
+            << "value " << testing::PrintToString(data[i]) << ", matcher " << testing::DescribeMatcher<T>(m);
+        ASSERT_EQ(f.matches(data[i]), expected);
+        if (expected && first == data.size()) {
+            first = i;
+        }
+    }
+    EXPECT_EQ(f.findFirst(data), first) << testing::DescribeMatcher<T>(m);
+}
+
+TEST(TestMatcher, BulkIntMatchesGmock)
+{
+    std::vector<int> data {INT_MIN, INT_MIN + 1, -7, -1, 0, 1, 2, 3, 4, 5, 6, 7, 100, INT_MAX - 1, INT_MAX};
+    std::mt19937 rng(11);
+    for (int i = 0; i < 1000; ++i) {
+        data.push_back(static_cast<int>(rng() % 41) - 20);
+        data.push_back(static_cast<int>(rng()));
+    }
+
+    // 块作用域里的 using 声明会遮住文件开头的 testing::Gt 等
+    using bulk::AllOf; using bulk::AnyOf; using bulk::Not;
+    using bulk::Eq; using bulk::Ge; using bulk::Gt; using bulk::Le; using bulk::Lt; using bulk::Ne;
+    const bulk::Expr<int> exprs[] = {
+        Gt(4), Lt(4), Ge(4), Le(4), Eq(4), Ne(4),
+        Gt(INT_MAX), Lt(INT_MIN), Ge(INT_MIN), Le(INT_MAX), Eq(INT_MIN), Ne(INT_MAX),
+        AllOf(Gt(3), Lt(6)), AnyOf(Lt(-5), Gt(5)), Not(AllOf(Gt(3), Lt(6))),
+        AllOf(Ge(0), Not(Eq(3)), Le(10), Ne(7)),
+        AnyOf(Eq(1), Eq(2), Eq(3), AllOf(Gt(10), Lt(15))),
+        AnyOf(Le(INT_MIN), Ge(INT_MAX)), Not(AnyOf(Lt(0), Gt(0))),
+        AllOf(Gt(5), Lt(5)), Not(Not(Gt(-3))),
+    };
+    for (const bulk::Expr<int> &e : exprs) {
+        ExpectSameAsGmock(e, data);
+    }
+}
+
+TEST(TestMatcher, BulkDoubleMatchesGmock)
+{
+    const double inf = std::numeric_limits<double>::infinity();
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+    const double tiny = std::numeric_limits<double>::denorm_min();
+    std::vector<double> data {-inf, -1e308, -4.0, -tiny, -0.0, 0.0, tiny, 3.0, 4.0, std::nextafter(4.0, 5.0),
+                              5.999, 6.0, 1e308, inf, nan, -nan};
+    std::mt19937 rng(13);
+    std::uniform_real_distribution<double> value(-10, 10);
+    for (int i = 0; i < 1000; ++i) {
+        data.push_back(value(rng));
+        data.push_back(std::round(value(rng)));
+    }
+
+    using bulk::AllOf; using bulk::AnyOf; using bulk::Not;
+    using bulk::Eq; using bulk::Ge; using bulk::Gt; using bulk::Le; using bulk::Lt; using bulk::Ne;
+    const bulk::Expr<double> exprs[] = {
+        Gt(4.0), Lt(4.0), Ge(4.0), Le(4.0), Eq(4.0), Ne(4.0),
+        Eq(0.0), Eq(-0.0), Ne(0.0), Gt(0.0), Lt(-0.0), Ge(-0.0),
+        Gt(inf), Lt(-inf), Ge(inf), Le(-inf), Eq(inf), Ne(-inf),
+        Gt(nan), Eq(nan), Ne(nan), Not(Gt(nan)),
+        AllOf(Gt(3.0), Lt(6.0)), Not(AllOf(Gt(3.0), Lt(6.0))), AnyOf(Lt(-5.0), Gt(5.0)),
+        Not(Ge(1.5)), AllOf(Ne(0.0), Not(Ne(0.0))), AnyOf(Eq(nan), Not(Eq(nan))),
+    };
+    for (const bulk::Expr<double> &e : exprs) {
+        ExpectSameAsGmock(e, data);
+    }
+}
@@ -0,0 +1,88 @@
+#ifndef __COMPLEX_H__
+#define __COMPLEX_H__
+
+#include <charconv>
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+// %f 格式下 double 的最长输出：符号 + 309 位整数 + 小数点 + 6 位小数
+constexpr size_t kMaxDoubleChars = 1 + 309 + 1 + 6;
+// "<r>+<i>i"
+constexpr size_t kMaxComplexChars = 2 * kMaxDoubleChars + 2;
+
+// 栈上的定长字符串，容纳任意 Complex 的格式化结果，不分配堆内存
+struct ComplexChars
+{
+    char data[kMaxComplexChars + 1];
+    size_t size = 0;
+
+    std::string_view view() const { return std::string_view(data, size); }
+    const char *c_str() const { return data; }
+};
+
+struct Complex 
+{
+    double r;
+    double i;
+
+    // 格式与 std::to_string 拼接的结果相同，例如 "1.000000+2.000000i"
+    // 写入 [first, last)，不追加 '\0'；空间不足时 ec 为 errc::value_too_large
+    std::to_chars_result format(char *first, char *last) const {
+        if (r == 0) {
+            if (i == 0)
+                return put(first, last, "0");
+            else 
+                return put(formatPart(first, last, i), last, "i");
+        } else {
+            if (i == 0)
+                return formatPart(first, last, r);
+            else
+                return put(formatPart(put(formatPart(first, last, r), last, "+"), last, i), last, "i");
+        }
+    }
+    ComplexChars toChars() const {
+        ComplexChars out;
+        auto res = format(out.data, out.data + kMaxComplexChars);
+        out.size = static_cast<size_t>(res.ptr - out.data);
+        out.data[out.size] = '\0';
+        return out;
+    }
+    std::string toString() const {
+        return std::string(toChars().view());
+    }
+    Complex Add(const Complex& a) const {
+        return Complex {r + a.r, i + a.i};
+    }
+    Complex Mul(const Complex& a) const {
+        return Complex {r * a.r - i * a.i, r * a.i + i * a.r};
+    }
+    Complex Conj() const {
+        return Complex {r, -i};
+    }
+
+private:
+    static std::to_chars_result formatPart(char *first, char *last, double v) {
+        return std::to_chars(first, last, v, std::chars_format::fixed, 6);
+    }
+    static std::to_chars_result formatPart(std::to_chars_result prev, char *last, double v) {
+        if (prev.ec != std::errc()) {
+            return prev;
+        }
+        return formatPart(prev.ptr, last, v);
+    }
+    static std::to_chars_result put(char *first, char *last, std::string_view s) {
+        if (static_cast<size_t>(last - first) < s.size()) {
+            return {last, std::errc::value_too_large};
+        }
+        return {s.copy(first, s.size()) + first, std::errc()};
+    }
+    static std::to_chars_result put(std::to_chars_result prev, char *last, std::string_view s) {
+        if (prev.ec != std::errc()) {
+            return prev;
+        }
+        return put(prev.ptr, last, s);
+    }
+};
+
+#endif
@@ -0,0 +1,144 @@
+#include "ComplexVector.h"
+#include <cassert>
+#include <immintrin.h>
+
+namespace {
+
+struct Kernels
+{
+    void (*add)(const double *, const double *, const double *, const double *,
+                double *, double *, size_t);
+    void (*mul)(const double *, const double *, const double *, const double *,
+                double *, double *, size_t);
+    void (*conj)(const double *, double *, size_t);
+};
+
+// 标量版本同时负责 SIMD 版本的尾部
+void add_scalar(const double *ar, const double *ai, const double *br, const double *bi,
+                double *outr, double *outi, size_t n)
+{
+    for (size_t k = 0; k < n; ++k) {
+        outr[k] = ar[k] + br[k];
+        outi[k] = ai[k] + bi[k];
+    }
+}
+
+void mul_scalar(const double *ar, const double *ai, const double *br, const double *bi,
+                double *outr, double *outi, size_t n)
+{
+    for (size_t k = 0; k < n; ++k) {
+        double r = ar[k] * br[k] - ai[k] * bi[k];
+        double i = ar[k] * bi[k] + ai[k] * br[k];
+        outr[k] = r;
+        outi[k] = i;
+    }
+}
+
+void conj_scalar(const double *ai, double *outi, size_t n)
+{
+    for (size_t k = 0; k < n; ++k) {
+        outi[k] = -ai[k];
+    }
+}
+
+__attribute__((target("avx")))
+void add_avx(const double *ar, const double *ai, const double *br, const double *bi,
+             double *outr, double *outi, size_t n)
+{
+    size_t k = 0;
+    for (; k + 4 <= n; k += 4) {
+        _mm256_storeu_pd(outr + k, _mm256_add_pd(_mm256_loadu_pd(ar + k), _mm256_loadu_pd(br + k)));
+        _mm256_storeu_pd(outi + k, _mm256_add_pd(_mm256_loadu_pd(ai + k), _mm256_loadu_pd(bi + k)));
+    }
+    add_scalar(ar + k, ai + k, br + k, bi + k, outr + k, outi + k, n - k);
+}
+
+// 不使用 FMA，保证与标量 Complex::Mul 的舍入一致
+__attribute__((target("avx")))
+void mul_avx(const double *ar, const double *ai, const double *br, const double *bi,
+             double *outr, double *outi, size_t n)
+{
+    size_t k = 0;
+    for (; k + 4 <= n; k += 4) {
+        __m256d xr = _mm256_loadu_pd(ar + k);
+        __m256d xi = _mm256_loadu_pd(ai + k);
+        __m256d yr = _mm256_loadu_pd(br + k);
+        __m256d yi = _mm256_loadu_pd(bi + k);
+        __m256d r = _mm256_sub_pd(_mm256_mul_pd(xr, yr), _mm256_mul_pd(xi, yi));
+        __m256d i = _mm256_add_pd(_mm256_mul_pd(xr, yi), _mm256_mul_pd(xi, yr));
+        _mm256_storeu_pd(outr + k, r);
+        _mm256_storeu_pd(outi + k, i);
+    }
+    mul_scalar(ar + k, ai + k, br + k, bi + k, outr + k, outi + k, n - k);
+}
+
+// 取负只翻转符号位，-0.0 和 NaN 的处理与标量取负相同
+__attribute__((target("avx")))
+void conj_avx(const double *ai, double *outi, size_t n)
+{
+    const __m256d sign = _mm256_set1_pd(-0.0);
+    size_t k = 0;
+    for (; k + 4 <= n; k += 4) {
+        _mm256_storeu_pd(outi + k, _mm256_xor_pd(_mm256_loadu_pd(ai + k), sign));
+    }
+    conj_scalar(ai + k, outi + k, n - k);
+}
+
+const Kernels &kernels()
+{
+    static const Kernels selected = [] {
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx")) {
+            return Kernels {add_avx, mul_avx, conj_avx};
+        }
+        return Kernels {add_scalar, mul_scalar, conj_scalar};
+    }();
+    return selected;
+}
+
+}
+
+ComplexVector::ComplexVector(const std::vector<Complex> &values)
+: _r(values.size())
+, _i(values.size())
+{
+    for (size_t k = 0; k < values.size(); ++k) {
+        _r[k] = values[k].r;
+        _i[k] = values[k].i;
+    }
+}
+
+std::vector<Complex> ComplexVector::toComplex() const
+{
+    std::vector<Complex> out(size());
+    for (size_t k = 0; k < size(); ++k) {
+        out[k] = Complex {_r[k], _i[k]};
+    }
+    return out;
+}
+
+ComplexVector ComplexVector::Add(const ComplexVector &a) const
+{
+    assert(size() == a.size());
+    ComplexVector out(size());
+    kernels().add(_r.data(), _i.data(), a._r.data(), a._i.data(),
+                  out._r.data(), out._i.data(), size());
+    return out;
+}
+
+ComplexVector ComplexVector::Mul(const ComplexVector &a) const
+{
+    assert(size() == a.size());
+    ComplexVector out(size());
+    kernels().mul(_r.data(), _i.data(), a._r.data(), a._i.data(),
+                  out._r.data(), out._i.data(), size());
+    return out;
+}
+
+ComplexVector ComplexVector::Conj() const
+{
+    ComplexVector out(size());
+    out._r = _r;
+    kernels().conj(_i.data(), out._i.data(), size());
+    return out;
+}
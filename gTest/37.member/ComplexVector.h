@@ -0,0 +1,35 @@
+#ifndef __COMPLEX_VECTOR_H__
+#define __COMPLEX_VECTOR_H__
+
+#include "Complex.h"
+#include <cstddef>
+#include <vector>
+
+// 列式存储的复数数组：实部、虚部各占一段连续内存
+// Add/Mul/Conj 逐元素计算，结果与 Complex 的同名方法逐位一致
+class ComplexVector
+{
+public:
+    ComplexVector() = default;
+    explicit ComplexVector(size_t n) : _r(n), _i(n) {}
+    explicit ComplexVector(const std::vector<Complex> &values);
+
+    std::vector<Complex> toComplex() const;
+
+    size_t size() const { return _r.size(); }
+    Complex operator[](size_t k) const { return Complex {_r[k], _i[k]}; }
+    void set(size_t k, const Complex &c) { _r[k] = c.r; _i[k] = c.i; }
+    const double *real() const { return _r.data(); }
+    const double *imag() const { return _i.data(); }
+
+    // 两个数组长度必须相同
+    ComplexVector Add(const ComplexVector &a) const;
+    ComplexVector Mul(const ComplexVector &a) const;
+    ComplexVector Conj() const;
+
+private:
+    std::vector<double> _r;
+    std::vector<double> _i;
+};
+
+#endif
@@ -0,0 +1,87 @@
+#include "Complex.h"
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <string>
+#include <vector>
+
+// 对比旧的 std::to_string 拼接与基于 std::to_chars 的格式化
+// 同时统计热路径上的堆分配次数，toChars/format 必须为 0
+// 用法：bench_to_string [数量，默认 10000000]
+
+static std::atomic<size_t> g_allocs{0};
+
+void *operator new(size_t size)
+{
+    g_allocs.fetch_add(1, std::memory_order_relaxed);
+    if (void *p = std::malloc(size ? size : 1)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void *p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void *p, size_t) noexcept
+{
+    std::free(p);
+}
+
+static std::string legacyToString(const Complex &c)
+{
+    if (c.r == 0) {
+        if (c.i == 0)
+            return "0";
+        else
+            return std::to_string(c.i) + "i";
+    } else {
+        if (c.i == 0)
+            return std::to_string(c.r);
+        else
+            return std::to_string(c.r) + "+" + std::to_string(c.i) + "i";
+    }
+}
+
+template <typename Func>
+bool run(const char *name, const std::vector<Complex> &values, Func func, bool mustNotAllocate)
+{
+    size_t total = 0;
+    size_t before = g_allocs.load();
+    auto start = std::chrono::steady_clock::now();
+    for (const Complex &c : values) {
+        total += func(c);
+    }
+    double s = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    size_t allocs = g_allocs.load() - before;
+    std::printf("%-10s %8.3f s  %8.1f ns/value  %6.2f allocs/value  (%zu chars)\n",
+                name, s, s * 1e9 / values.size(), static_cast<double>(allocs) / values.size(), total);
+    if (mustNotAllocate && allocs != 0) {
+        std::printf("%s: expected zero heap allocations, got %zu\n", name, allocs);
+        return false;
+    }
+    return true;
+}
+
+int main(int argc, char **argv)
+{
+    size_t n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10000000;
+    std::vector<Complex> values(n);
+    for (size_t k = 0; k < n; ++k) {
+        values[k] = Complex {static_cast<double>(k % 1000) - 500.25, static_cast<double>(k % 97) * 0.5};
+    }
+
+    bool ok = true;
+    ok &= run("legacy", values, [](const Complex &c) { return legacyToString(c).size(); }, false);
+    ok &= run("toString", values, [](const Complex &c) { return c.toString().size(); }, false);
+    ok &= run("toChars", values, [](const Complex &c) { return c.toChars().size; }, true);
+    char buf[kMaxComplexChars];
+    ok &= run("format", values, [&buf](const Complex &c) {
+        return static_cast<size_t>(c.format(buf, buf + sizeof(buf)).ptr - buf);
+    }, true);
+    return ok ? 0 : 1;
+}
@@ -4,28 +4,12 @@
 #include <gmock/gmock-matchers.h>
 #include <string>
 #include <ostream>
-
-struct Complex 
-{
-    double r;
-    double i;
-    std::string toString() const {
-        if (r == 0) {
-            if (i == 0)
-                return "0";
-            else 
-                return std::to_string(i) + "i";
-        } else {
-            if (i == 0)
-                return std::to_string(r);
-            else 
-                return std::to_string(r) + "+" + std::to_string(i) + "i";
-        }
-    }
-    Complex Add(const Complex& a) const {
-        return Complex {r + a.r, i + a.i};
-    }
-};
+#include <cfloat>
+#include <cmath>
+#include <vector>
+#include "Complex.h"
+#include "alloc_tracking.h"
+#include "ComplexVector.h"
 
 class Calc
 {
@@ -86,3 +70,148 @@ TEST(TestCalc, Case3)
         Field("i", &Complex::i, Gt(10))), _));
     calc.calc(Complex {1, 11}, Complex {1, 11});
 }
+
+static std::vector<Complex> MakeComplexes(size_t n, double seed)
+{
+    std::vector<Complex> v;
+    for (size_t k = 0; k < n; ++k) {
+        v.push_back(Complex {seed * k - 3.5, 0.25 * k + seed});
+    }
+    return v;
+}
+
+static void ExpectSame(const Complex &actual, const Complex &expected, size_t k)
+{
+    EXPECT_EQ(actual.r, expected.r) << "k = " << k;
+    EXPECT_EQ(actual.i, expected.i) << "k = " << k;
+}
+
+TEST(ComplexVectorTest, RoundTrip)
+{
+    auto values = MakeComplexes(13, 1.5);
+    ComplexVector cv(values);
+    ASSERT_EQ(cv.size(), values.size());
+    auto back = cv.toComplex();
+    for (size_t k = 0; k < values.size(); ++k) {
+        ExpectSame(back[k], values[k], k);
+        ExpectSame(cv[k], values[k], k);
+    }
+}
+
+// 各种长度都覆盖到 SIMD 主循环和尾部，结果以 Complex::Add 为准
+TEST(ComplexVectorTest, AddMatchesComplexAdd)
+{
+    for (size_t n = 0; n <= 19; ++n) {
+        auto a = MakeComplexes(n, 0.7);
+        auto b = MakeComplexes(n, -1.3);
+        auto sum = ComplexVector(a).Add(ComplexVector(b));
+        ASSERT_EQ(sum.size(), n);
+        for (size_t k = 0; k < n; ++k) {
+            ExpectSame(sum[k], a[k].Add(b[k]), k);
+        }
+    }
+}
+
+TEST(ComplexVectorTest, MulMatchesComplexMul)
+{
+    for (size_t n = 0; n <= 19; ++n) {
+        auto a = MakeComplexes(n, 0.1);
+        auto b = MakeComplexes(n, 2.9);
+        auto prod = ComplexVector(a).Mul(ComplexVector(b));
+        for (size_t k = 0; k < n; ++k) {
+            ExpectSame(prod[k], a[k].Mul(b[k]), k);
+        }
+    }
+    ComplexVector i(std::vector<Complex> {{0, 1}});
+    ExpectSame(i.Mul(i)[0], Complex {-1, 0}, 0);
+}
+
+TEST(ComplexVectorTest, ConjMatchesComplexConj)
+{
+    auto a = MakeComplexes(11, 0.0);
+    auto conj = ComplexVector(a).Conj();
+    for (size_t k = 0; k < a.size(); ++k) {
+        ExpectSame(conj[k], a[k].Conj(), k);
+    }
+    // z * conj(z) 的虚部为 0
+    auto cv = ComplexVector(a);
+    auto norm = cv.Mul(cv.Conj());
+    for (size_t k = 0; k < a.size(); ++k) {
+        EXPECT_EQ(norm[k].i, 0.0) << "k = " << k;
+    }
+}
+
+// 旧的拼接实现，作为格式化结果的参照
+static std::string LegacyToString(const Complex &c)
+{
+    if (c.r == 0) {
+        if (c.i == 0)
+            return "0";
+        else
+            return std::to_string(c.i) + "i";
+    } else {
+        if (c.i == 0)
+            return std::to_string(c.r);
+        else
+            return std::to_string(c.r) + "+" + std::to_string(c.i) + "i";
+    }
+}
+
+TEST(ComplexFormatTest, MatchesLegacyToString)
+{
+    const double values[] = {0.0, -0.0, 1.0, -2.5, 3.14159265, 1e-7, -1e-7, 0.0000005,
+                             123456789.123456789, 1e300, -DBL_MAX, DBL_MIN, INFINITY, -INFINITY};
+    for (double r : values) {
+        for (double i : values) {
+            Complex c {r, i};
+            std::string expected = LegacyToString(c);
+            EXPECT_EQ(std::string(c.toChars().view()), expected);
+            EXPECT_STREQ(c.toChars().c_str(), expected.c_str());
+            EXPECT_EQ(c.toString(), expected);
+        }
+    }
+}
+
+TEST(ComplexFormatTest, CallerSuppliedBuffer)
+{
+    Complex c {3, 2};
+    char buf[32];
+    auto res = c.format(buf, buf + sizeof(buf));
+    ASSERT_EQ(res.ec, std::errc());
+    EXPECT_EQ(std::string(buf, res.ptr), "3.000000+2.000000i");
+
+    // 空间不足时报告错误，不越界
+    char small[8];
+    res = c.format(small, small + sizeof(small));
+    EXPECT_EQ(res.ec, std::errc::value_too_large);
+
+    char exact[18];
+    res = c.format(exact, exact + sizeof(exact));
+    ASSERT_EQ(res.ec, std::errc());
+    EXPECT_EQ(res.ptr, exact + sizeof(exact));
+}
+
+TEST(ComplexFormatTest, LongestValueFits)
+{
+    Complex c {-DBL_MAX, -DBL_MAX};
+    ComplexChars chars = c.toChars();
+    EXPECT_EQ(chars.size, kMaxComplexChars);
+    EXPECT_EQ(chars.view(), LegacyToString(c));
+}
+
+TEST(ComplexNoAlloc, AddAndFormatDoNotAllocate)
+{
+    Complex a {1.5, -2.25};
+    Complex b {-0.5, 4};
+    Complex sum {};
+    ComplexChars chars;
+    char buf[64];
+    size_t written = 0;
+    EXPECT_NO_ALLOC {
+        sum = a.Add(b).Mul(a).Conj();
+        chars = sum.toChars();
+        written = static_cast<size_t>(a.format(buf, buf + sizeof(buf)).ptr - buf);
+    }
+    EXPECT_EQ(chars.view(), LegacyToString(sum));
+    EXPECT_EQ(std::string(buf, written), "1.500000+-2.250000i");
+}
@@ -0,0 +1,66 @@
+#include "divisor.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+// 对 100M 个随机 int 判断能否被 d 整除：% 逐个取模 / Divisor::divides 逐个判断 / divisibleMask 批量
+// 用法：bench_divisor [元素个数，默认 100000000]
+
+static double seconds(std::chrono::steady_clock::time_point start)
+{
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+// 除数从命令行之外的地方来，编译器不能把 % 优化成常数除法
+static int __attribute__((noinline)) opaque(int d)
+{
+    return d;
+}
+
+int main(int argc, char **argv)
+{
+    size_t n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 100000000;
+    std::vector<int> data(n);
+    std::mt19937 rng(1);
+    for (int &x : data) {
+        x = static_cast<int>(rng());
+    }
+    std::vector<uint64_t> mask((n + 63) / 64);
+
+    std::printf("%6s %12s %12s %12s %12s\n", "d", "% (s)", "divides (s)", "mask (s)", "divisible");
+    for (int d : {3, 7, 10, 1000, 65536}) {
+        int dd = opaque(d);
+
+        auto start = std::chrono::steady_clock::now();
+        size_t byMod = 0;
+        for (int x : data) {
+            byMod += x % dd == 0;
+        }
+        double modSec = seconds(start);
+
+        Divisor div(dd);
+        start = std::chrono::steady_clock::now();
+        size_t byDivides = 0;
+        for (int x : data) {
+            byDivides += div.divides(x);
+        }
+        double dividesSec = seconds(start);
+
+        start = std::chrono::steady_clock::now();
+        div.divisibleMask(data.data(), n, mask.data());
+        size_t byMask = 0;
+        for (uint64_t w : mask) {
+            byMask += __builtin_popcountll(w);
+        }
+        double maskSec = seconds(start);
+
+        if (byMod != byDivides || byMod != byMask) {
+            std::printf("mismatch for d = %d: %zu %zu %zu\n", d, byMod, byDivides, byMask);
+            return 1;
+        }
+        std::printf("%6d %12.4f %12.4f %12.4f %12zu\n", d, modSec, dividesSec, maskSec, byMod);
+    }
+    return 0;
+}
@@ -2,6 +2,10 @@
 #include <gtest/gtest.h>
 #include <gmock/gmock.h>
 #include <gtest/gtest-matchers.h>
+#include "divisor.h"
+#include <climits>
+#include <random>
+#include <vector>
 #include <ostream>
 #include <string>
 
@@ -10,24 +14,32 @@ class DivMatcher
 public:
     using is_gtest_matcher = int;
 
-    explicit DivMatcher(int n)
+    // quiet 时不打印每次调用，只在不匹配时把余数写进 gtest 的说明里
+    explicit DivMatcher(int n, bool quiet = false)
         : _data(n)
+        , _quiet(quiet)
     {}
-    bool MatchAndExplain(int param, std::ostream *) const {
-        std::cout << "param = " << param 
-            << ", _data = " << _data 
-            << "param % _data => " << (param % _data)
-            << "\n";
-        return param % _data == 0;
+    bool MatchAndExplain(int param, std::ostream *os) const {
+        bool ok = _data.divides(param);
+        if (!_quiet) {
+            std::cout << "param = " << param 
+                << ", _data = " << _data.value() 
+                << "param % _data => " << _data.remainder(param)
+                << "\n";
+        } else if (!ok && os) {
+            *os << "param % " << _data.value() << " = " << _data.remainder(param);
+        }
+        return ok;
     }
     void DescribeTo(std::ostream *os) const {
-        *os << "Can't be divided by " << _data << std::endl;
+        *os << "Can't be divided by " << _data.value() << std::endl;
     }
     void DescribeNegationTo(std::ostream *os) const {
-        *os << "Can be divided by " << _data << std::endl;
+        *os << "Can be divided by " << _data.value() << std::endl;
     }
 private:
-    int _data;
+    Divisor _data;
+    bool _quiet;
 };
 
 using testing::Matcher;
@@ -35,6 +47,10 @@ using testing::Matcher;
     return DivMatcher(n);
 }
 
+::testing::Matcher<int> QuietDiv(int n) {
+    return DivMatcher(n, true);
+}
+
 class Calc
 {
 public:
@@ -84,3 +100,61 @@ TEST(TestCalc, Case3)
     /* mc.calc(6, 10); */
     mc.calc(7, 10);
 }
+
+TEST(DivisorTest, MatchesModulo)
+{
+    const int divisors[] = {1, -1, 2, 3, -3, 5, 6, 7, 10, 12, -16, 24, 1000, 65536, 99991, INT_MAX, INT_MIN};
+    std::vector<int> values = {0, 1, -1, 2, -2, INT_MAX, INT_MIN, INT_MIN + 1, 65536, -65536};
+    std::mt19937 rng(3);
+    for (int i = 0; i < 2000; ++i) {
+        values.push_back(static_cast<int>(rng()));
+        values.push_back(static_cast<int>(rng() % 2001) - 1000);
+    }
+    for (int d : divisors) {
+        Divisor div(d);
+        for (int n : values) {
+            bool expected = d == -1 || n % d == 0;
+            ASSERT_EQ(div.divides(n), expected) << n << " / " << d;
+        }
+    }
+    EXPECT_THROW(Divisor(0), std::invalid_argument);
+}
+
+TEST(DivisorTest, DivisibleMaskMatchesScalar)
+{
+    std::mt19937 rng(5);
+    // 64 的整数倍和零头都覆盖到
+    for (size_t n : {0, 1, 63, 64, 65, 200, 1000}) {
+        std::vector<int> data(n);
+        for (int &x : data) {
+            x = static_cast<int>(rng() % 100000) - 50000;
+        }
+        for (int d : {1, 3, -4, 7, 96, INT_MIN}) {
+            Divisor div(d);
+            std::vector<uint64_t> mask = div.divisibleMask(data);
+            ASSERT_EQ(mask.size(), (n + 63) / 64);
+            size_t count = 0;
+            for (size_t i = 0; i < n; ++i) {
+                bool bit = (mask[i / 64] >> (i % 64)) & 1;
+                ASSERT_EQ(bit, div.divides(data[i])) << "i = " << i << ", d = " << d;
+                count += bit;
+            }
+            EXPECT_EQ(div.countDivisible(data.data(), n), count);
+        }
+    }
+}
+
+TEST(DivisorTest, QuietDivExplainsOnlyOnFailure)
+{
+    testing::StringMatchResultListener ok;
+    EXPECT_TRUE(testing::ExplainMatchResult(QuietDiv(3), 9, &ok));
+    EXPECT_EQ(ok.str(), "");
+
+    testing::StringMatchResultListener failed;
+    EXPECT_FALSE(testing::ExplainMatchResult(QuietDiv(3), 10, &failed));
+    EXPECT_EQ(failed.str(), "param % 3 = 1");
+
+    MockCalc mc;
+    EXPECT_CALL(mc, calc(QuietDiv(3), QuietDiv(5)));
+    mc.calc(6, 10);
+}
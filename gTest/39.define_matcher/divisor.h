@@ -0,0 +1,160 @@
+#ifndef __DIVISOR_H__
+#define __DIVISOR_H__
+
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+
+// 固定除数的整除判断，用乘法和比较代替除法
+//
+// 把 |d| 写成 odd << k，构造时预先算好 odd 在 2^32 下的乘法逆元 inv 和 limit = (2^32 - 1) / |d|
+// 对 u = |n|：u 能被 |d| 整除  <=>  rotr(u * inv, k) <= limit（都是 32 位无符号运算）
+// 整除时 u * inv 恰好是商，rotr 之后不超过 limit；不整除时结果一定大于 limit（Hacker's Delight 10-16）
+//
+// divisibleMask 一次判断一批数，结果按位放在 uint64_t 数组里（第 i 个数对应第 i / 64 个字的第 i % 64 位）
+// 有 AVX2 时一次处理 8 个，否则用 SSE2 一次 4 个
+class Divisor
+{
+public:
+    explicit Divisor(int d)
+    : _d(d)
+    {
+        if (d == 0) {
+            throw std::invalid_argument("Divisor: division by zero");
+        }
+        uint32_t ad = abs32(d);
+        while ((ad & 1) == 0) {
+            ad >>= 1;
+            ++_shift;
+        }
+        // 牛顿迭代，每次精度翻倍：x = d 时低 3 位已经正确，4 次后超过 32 位
+        uint32_t inv = ad;
+        for (int i = 0; i < 4; ++i) {
+            inv *= 2 - ad * inv;
+        }
+        _inv = inv;
+        _limit = UINT32_MAX / abs32(d);
+    }
+
+    int value() const { return _d; }
+
+    bool divides(int n) const
+    {
+        uint32_t q = abs32(n) * _inv;
+        return rotr(q, _shift) <= _limit;
+    }
+
+    // 只在需要说明原因时才用，走普通的取模
+    int remainder(int n) const { return _d == -1 ? 0 : n % _d; }
+
+    // mask 至少要有 (n + 63) / 64 个字
+    void divisibleMask(const int *data, size_t n, uint64_t *mask) const
+    {
+        size_t words = n / 64;
+        for (size_t w = 0; w < words; ++w) {
+            mask[w] = maskWord(data + w * 64);
+        }
+        size_t rest = n % 64;
+        if (rest) {
+            uint64_t bits = 0;
+            for (size_t i = 0; i < rest; ++i) {
+                bits |= static_cast<uint64_t>(divides(data[words * 64 + i])) << i;
+            }
+            mask[words] = bits;
+        }
+    }
+
+    std::vector<uint64_t> divisibleMask(const std::vector<int> &data) const
+    {
+        std::vector<uint64_t> mask((data.size() + 63) / 64);
+        divisibleMask(data.data(), data.size(), mask.data());
+        return mask;
+    }
+
+    size_t countDivisible(const int *data, size_t n) const
+    {
+        size_t count = 0;
+        for (size_t w = 0; w < n / 64; ++w) {
+            count += __builtin_popcountll(maskWord(data + w * 64));
+        }
+        for (size_t i = n / 64 * 64; i < n; ++i) {
+            count += divides(data[i]);
+        }
+        return count;
+    }
+
+private:
+    static uint32_t abs32(int n)
+    {
+        // INT_MIN 的绝对值 2^31 也能表示
+        return n < 0 ? 0u - static_cast<uint32_t>(n) : static_cast<uint32_t>(n);
+    }
+
+    static uint32_t rotr(uint32_t x, int k) { return k ? (x >> k) | (x << (32 - k)) : x; }
+
+    // 连续 64 个数的结果
+    uint64_t maskWord(const int *p) const
+    {
+#if defined(__AVX2__)
+        const __m256i inv = _mm256_set1_epi32(static_cast<int>(_inv));
+        const __m256i limit = _mm256_set1_epi32(static_cast<int>(_limit ^ 0x80000000u));
+        const __m256i sign = _mm256_set1_epi32(static_cast<int>(0x80000000u));
+        const __m128i right = _mm_cvtsi32_si128(_shift);
+        const __m128i left = _mm_cvtsi32_si128(32 - _shift);
+        uint64_t bits = 0;
+        for (int i = 0; i < 64; i += 8) {
+            __m256i x = _mm256_abs_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i *>(p + i)));
+            __m256i q = _mm256_mullo_epi32(x, inv);
+            q = _mm256_or_si256(_mm256_srl_epi32(q, right), _mm256_sll_epi32(q, left));
+            // 无符号的 q <= limit 等价于两边翻转符号位后的有符号比较
+            __m256i gt = _mm256_cmpgt_epi32(_mm256_xor_si256(q, sign), limit);
+            uint32_t m = ~static_cast<uint32_t>(_mm256_movemask_ps(_mm256_castsi256_ps(gt))) & 0xFF;
+            bits |= static_cast<uint64_t>(m) << i;
+        }
+        return bits;
+#elif defined(__SSE2__)
+        const __m128i inv = _mm_set1_epi32(static_cast<int>(_inv));
+        const __m128i limit = _mm_set1_epi32(static_cast<int>(_limit ^ 0x80000000u));
+        const __m128i sign = _mm_set1_epi32(static_cast<int>(0x80000000u));
+        const __m128i right = _mm_cvtsi32_si128(_shift);
+        const __m128i left = _mm_cvtsi32_si128(32 - _shift);
+        uint64_t bits = 0;
+        for (int i = 0; i < 64; i += 4) {
+            __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p + i));
+            // SSE2 没有 abs_epi32：(x ^ s) - s，s 是符号位扩展
+            __m128i s = _mm_srai_epi32(x, 31);
+            x = _mm_sub_epi32(_mm_xor_si128(x, s), s);
+            // SSE2 也没有 32 位乘法取低位：偶数、奇数通道分别用 mul_epu32 再拼回来
+            __m128i even = _mm_mul_epu32(x, inv);
+            __m128i odd = _mm_mul_epu32(_mm_srli_epi64(x, 32), inv);
+            __m128i q = _mm_unpacklo_epi32(_mm_shuffle_epi32(even, _MM_SHUFFLE(0, 0, 2, 0)),
+                                           _mm_shuffle_epi32(odd, _MM_SHUFFLE(0, 0, 2, 0)));
+            q = _mm_or_si128(_mm_srl_epi32(q, right), _mm_sll_epi32(q, left));
+            __m128i gt = _mm_cmpgt_epi32(_mm_xor_si128(q, sign), limit);
+            uint32_t m = ~static_cast<uint32_t>(_mm_movemask_ps(_mm_castsi128_ps(gt))) & 0xF;
+            bits |= static_cast<uint64_t>(m) << i;
+        }
+        return bits;
+#else
+        uint64_t bits = 0;
+        for (int i = 0; i < 64; ++i) {
+            bits |= static_cast<uint64_t>(divides(p[i])) << i;
+        }
+        return bits;
+#endif
+    }
+
+    int _d;
+    int _shift = 0;
+    uint32_t _inv = 0;
+    uint32_t _limit = 0;
+};
+
+#endif
@@ -0,0 +1,108 @@
+#include "ring_buffer.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+// 对比 SpscRingBuffer / MpmcRingBuffer 与加锁的 std::queue
+// 吞吐：producers 个线程各写 items 个元素，consumers 个线程读完为止
+// 延迟：元素里带入队时间戳，出队时计算差值
+// 用法：bench_ring_buffer [每个生产者的元素数，默认 1000000]
+
+using Clock = std::chrono::steady_clock;
+
+class LockedQueue
+{
+public:
+    explicit LockedQueue(size_t) {}
+
+    bool try_push(Clock::rep v)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _queue.push(v);
+        return true;
+    }
+
+    bool try_pop(Clock::rep &out)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (_queue.empty()) {
+            return false;
+        }
+        out = _queue.front();
+        _queue.pop();
+        return true;
+    }
+
+private:
+    std::mutex _mutex;
+    std::queue<Clock::rep> _queue;
+};
+
+template <typename Queue>
+void run(const char *name, int producers, int consumers, size_t items)
+{
+    Queue q(4096);
+    const size_t total = items * producers;
+    std::atomic<size_t> consumed{0};
+    std::vector<std::vector<double>> latencies(consumers);
+
+    auto start = Clock::now();
+    std::vector<std::thread> threads;
+    for (int p = 0; p < producers; ++p) {
+        threads.emplace_back([&] {
+            for (size_t i = 0; i < items; ++i) {
+                while (!q.try_push(Clock::now().time_since_epoch().count())) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+    for (int c = 0; c < consumers; ++c) {
+        threads.emplace_back([&, c] {
+            auto &lat = latencies[c];
+            lat.reserve(total / consumers + 1);
+            Clock::rep stamp;
+            while (consumed.load(std::memory_order_relaxed) < total) {
+                if (!q.try_pop(stamp)) {
+                    std::this_thread::yield();
+                    continue;
+                }
+                lat.push_back(static_cast<double>(Clock::now().time_since_epoch().count() - stamp));
+                consumed.fetch_add(1, std::memory_order_relaxed);
+            }
+        });
+    }
+    for (auto &t : threads) {
+        t.join();
+    }
+    double s = std::chrono::duration<double>(Clock::now() - start).count();
+
+    std::vector<double> all;
+    for (auto &v : latencies) {
+        all.insert(all.end(), v.begin(), v.end());
+    }
+    std::sort(all.begin(), all.end());
+    auto at = [&all](double q) { return all[static_cast<size_t>(q * (all.size() - 1))] / 1000.0; };
+    std::printf("%-12s %dP/%dC  %8.2f Mitems/s  latency p50 %9.2f us  p99 %9.2f us\n",
+                name, producers, consumers, total / s / 1e6, at(0.5), at(0.99));
+}
+
+int main(int argc, char **argv)
+{
+    size_t items = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000000;
+
+    run<SpscRingBuffer<Clock::rep>>("spsc", 1, 1, items);
+    run<LockedQueue>("mutex+queue", 1, 1, items);
+
+    run<MpmcRingBuffer<Clock::rep>>("mpmc", 1, 1, items);
+    run<MpmcRingBuffer<Clock::rep>>("mpmc", 4, 4, items / 4);
+    run<LockedQueue>("mutex+queue", 4, 4, items / 4);
+    return 0;
+}
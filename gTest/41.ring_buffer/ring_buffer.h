@@ -0,0 +1,216 @@
+#ifndef __RING_BUFFER_H__
+#define __RING_BUFFER_H__
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <utility>
+
+// 由笔记中的循环队列（Interview/3_面向对象.md）演变而来的两个有界无锁环形队列
+// - 容量向上取整到 2 的幂，下标用 & mask 代替 % size
+// - 读写位置是单调递增的计数器，不再浪费一个槽位来区分空和满
+// - 容量固定，不做 resize，满了 try_push 返回 false 由调用方决定重试还是丢弃
+
+constexpr size_t kCacheLineSize = 64;
+
+inline size_t roundUpPowerOfTwo(size_t n)
+{
+    size_t cap = 1;
+    while (cap < n) {
+        cap <<= 1;
+    }
+    return cap;
+}
+
+// 单生产者/单消费者
+// head 只由消费者写，tail 只由生产者写，两者分别独占一个缓存行
+// 双方各自缓存一份对方的位置，只有看起来空/满时才重新读取对方的原子变量
+template <typename T>
+class SpscRingBuffer
+{
+public:
+    explicit SpscRingBuffer(size_t capacity)
+    : _mask(roundUpPowerOfTwo(capacity < 1 ? 1 : capacity) - 1)
+    , _slots(new Slot[_mask + 1])
+    {}
+
+    ~SpscRingBuffer()
+    {
+        size_t head = _head.load(std::memory_order_relaxed);
+        size_t tail = _tail.load(std::memory_order_relaxed);
+        for (; head != tail; ++head) {
+            _slots[head & _mask].get()->~T();
+        }
+    }
+
+    SpscRingBuffer(const SpscRingBuffer &) = delete;
+    SpscRingBuffer &operator=(const SpscRingBuffer &) = delete;
+
+    template <typename... Args>
+    bool try_emplace(Args &&...args)
+    {
+        const size_t tail = _tail.load(std::memory_order_relaxed);
+        if (tail - _cachedHead > _mask) {
+            _cachedHead = _head.load(std::memory_order_acquire);
+            if (tail - _cachedHead > _mask) {
+                return false;
+            }
+        }
+        new (_slots[tail & _mask].storage) T(std::forward<Args>(args)...);
+        _tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool try_push(const T &value) { return try_emplace(value); }
+    bool try_push(T &&value) { return try_emplace(std::move(value)); }
+
+    bool try_pop(T &out)
+    {
+        const size_t head = _head.load(std::memory_order_relaxed);
+        if (head == _cachedTail) {
+            _cachedTail = _tail.load(std::memory_order_acquire);
+            if (head == _cachedTail) {
+                return false;
+            }
+        }
+        T *p = _slots[head & _mask].get();
+        out = std::move(*p);
+        p->~T();
+        _head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    size_t capacity() const { return _mask + 1; }
+
+    // 并发读写时只是近似值
+    size_t size() const
+    {
+        return _tail.load(std::memory_order_acquire) - _head.load(std::memory_order_acquire);
+    }
+    bool empty() const { return size() == 0; }
+
+private:
+    struct Slot
+    {
+        alignas(T) unsigned char storage[sizeof(T)];
+        T *get() { return std::launder(reinterpret_cast<T *>(storage)); }
+    };
+
+    const size_t _mask;
+    const std::unique_ptr<Slot[]> _slots;
+
+    alignas(kCacheLineSize) std::atomic<size_t> _head{0};
+    size_t _cachedTail = 0;
+
+    alignas(kCacheLineSize) std::atomic<size_t> _tail{0};
+    size_t _cachedHead = 0;
+};
+
+// 多生产者/多消费者（Vyukov 有界队列）
+// 每个槽位带一个序号：seq == pos 表示可写，seq == pos + 1 表示可读
+// 生产者、消费者各自用 CAS 抢占位置，抢到后只访问自己的槽位
+template <typename T>
+class MpmcRingBuffer
+{
+public:
+    explicit MpmcRingBuffer(size_t capacity)
+    : _mask(roundUpPowerOfTwo(capacity < 2 ? 2 : capacity) - 1)
+    , _slots(new Slot[_mask + 1])
+    {
+        for (size_t i = 0; i <= _mask; ++i) {
+            _slots[i].seq.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    ~MpmcRingBuffer()
+    {
+        size_t head = _dequeuePos.load(std::memory_order_relaxed);
+        size_t tail = _enqueuePos.load(std::memory_order_relaxed);
+        for (; head != tail; ++head) {
+            _slots[head & _mask].get()->~T();
+        }
+    }
+
+    MpmcRingBuffer(const MpmcRingBuffer &) = delete;
+    MpmcRingBuffer &operator=(const MpmcRingBuffer &) = delete;
+
+    template <typename... Args>
+    bool try_emplace(Args &&...args)
+    {
+        size_t pos = _enqueuePos.load(std::memory_order_relaxed);
+        Slot *slot;
+        for (;;) {
+            slot = &_slots[pos & _mask];
+            size_t seq = slot->seq.load(std::memory_order_acquire);
+            intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+            if (diff == 0) {
+                if (_enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (diff < 0) {
+                return false;
+            } else {
+                pos = _enqueuePos.load(std::memory_order_relaxed);
+            }
+        }
+        new (slot->storage) T(std::forward<Args>(args)...);
+        slot->seq.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool try_push(const T &value) { return try_emplace(value); }
+    bool try_push(T &&value) { return try_emplace(std::move(value)); }
+
+    bool try_pop(T &out)
+    {
+        size_t pos = _dequeuePos.load(std::memory_order_relaxed);
+        Slot *slot;
+        for (;;) {
+            slot = &_slots[pos & _mask];
+            size_t seq = slot->seq.load(std::memory_order_acquire);
+            intptr_t diff = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos + 1);
+            if (diff == 0) {
+                if (_dequeuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (diff < 0) {
+                return false;
+            } else {
+                pos = _dequeuePos.load(std::memory_order_relaxed);
+            }
+        }
+        T *p = slot->get();
+        out = std::move(*p);
+        p->~T();
+        slot->seq.store(pos + _mask + 1, std::memory_order_release);
+        return true;
+    }
+
+    size_t capacity() const { return _mask + 1; }
+
+    size_t size() const
+    {
+        size_t tail = _enqueuePos.load(std::memory_order_acquire);
+        size_t head = _dequeuePos.load(std::memory_order_acquire);
+        return tail > head ? tail - head : 0;
+    }
+    bool empty() const { return size() == 0; }
+
+private:
+    struct Slot
+    {
+        std::atomic<size_t> seq;
+        alignas(T) unsigned char storage[sizeof(T)];
+        T *get() { return std::launder(reinterpret_cast<T *>(storage)); }
+    };
+
+    const size_t _mask;
+    const std::unique_ptr<Slot[]> _slots;
+
+    alignas(kCacheLineSize) std::atomic<size_t> _enqueuePos{0};
+    alignas(kCacheLineSize) std::atomic<size_t> _dequeuePos{0};
+};
+
+#endif
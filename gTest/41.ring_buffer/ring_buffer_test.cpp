@@ -0,0 +1,172 @@
+#include "ring_buffer.h"
+#include <gtest/gtest.h>
+#include <atomic>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+template <typename Queue>
+class RingBufferTest : public ::testing::Test {};
+
+using RingBufferTypes = ::testing::Types<SpscRingBuffer<int>, MpmcRingBuffer<int>>;
+TYPED_TEST_SUITE(RingBufferTest, RingBufferTypes);
+
+TYPED_TEST(RingBufferTest, CapacityRoundsUpToPowerOfTwo) {
+    TypeParam q5(5);
+    EXPECT_EQ(q5.capacity(), 8);
+    TypeParam q8(8);
+    EXPECT_EQ(q8.capacity(), 8);
+}
+
+TYPED_TEST(RingBufferTest, FifoAndFull) {
+    TypeParam q(4);
+    int v = 0;
+    EXPECT_TRUE(q.empty());
+    EXPECT_FALSE(q.try_pop(v));
+
+    for (int i = 0; i < 4; ++i) {
+        EXPECT_TRUE(q.try_push(i));
+    }
+    EXPECT_FALSE(q.try_push(4));
+    EXPECT_EQ(q.size(), 4);
+
+    for (int i = 0; i < 4; ++i) {
+        ASSERT_TRUE(q.try_pop(v));
+        EXPECT_EQ(v, i);
+    }
+    EXPECT_FALSE(q.try_pop(v));
+}
+
+// 读写位置多次绕过数组末尾
+TYPED_TEST(RingBufferTest, WrapAround) {
+    TypeParam q(4);
+    int v = 0;
+    for (int i = 0; i < 100; ++i) {
+        ASSERT_TRUE(q.try_push(i));
+        ASSERT_TRUE(q.try_push(i + 1000));
+        ASSERT_TRUE(q.try_pop(v));
+        EXPECT_EQ(v, i);
+        ASSERT_TRUE(q.try_pop(v));
+        EXPECT_EQ(v, i + 1000);
+    }
+    EXPECT_TRUE(q.empty());
+}
+
+struct Counted
+{
+    static int alive;
+    Counted() { ++alive; }
+    Counted(const Counted &) { ++alive; }
+    Counted &operator=(const Counted &) = default;
+    ~Counted() { --alive; }
+};
+int Counted::alive = 0;
+
+TEST(RingBufferLifetime, DestroysRemainingElements) {
+    {
+        SpscRingBuffer<Counted> spsc(8);
+        MpmcRingBuffer<Counted> mpmc(8);
+        Counted c;
+        for (int i = 0; i < 3; ++i) {
+            spsc.try_push(c);
+            mpmc.try_push(c);
+        }
+        Counted out;
+        spsc.try_pop(out);
+        mpmc.try_pop(out);
+        EXPECT_EQ(Counted::alive, 2 + 2 + 2);
+    }
+    EXPECT_EQ(Counted::alive, 0);
+}
+
+TEST(RingBufferLifetime, MoveOnlyType) {
+    SpscRingBuffer<std::unique_ptr<std::string>> spsc(2);
+    MpmcRingBuffer<std::unique_ptr<std::string>> mpmc(2);
+    EXPECT_TRUE(spsc.try_emplace(new std::string("spsc")));
+    EXPECT_TRUE(mpmc.try_push(std::make_unique<std::string>("mpmc")));
+
+    std::unique_ptr<std::string> out;
+    ASSERT_TRUE(spsc.try_pop(out));
+    EXPECT_EQ(*out, "spsc");
+    ASSERT_TRUE(mpmc.try_pop(out));
+    EXPECT_EQ(*out, "mpmc");
+}
+
+// 一个生产者一个消费者，消费者看到的顺序必须与写入顺序一致
+TEST(RingBufferStress, SpscPreservesOrder) {
+    const int kItems = 1000000;
+    SpscRingBuffer<int> q(1024);
+
+    std::thread producer([&q] {
+        for (int i = 0; i < kItems; ++i) {
+            while (!q.try_push(i)) {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    int expected = 0;
+    int v;
+    while (expected < kItems) {
+        if (q.try_pop(v)) {
+            ASSERT_EQ(v, expected);
+            ++expected;
+        } else {
+            std::this_thread::yield();
+        }
+    }
+    producer.join();
+    EXPECT_TRUE(q.empty());
+}
+
+// 多个生产者、多个消费者，每个元素恰好被消费一次，且同一生产者的元素保持相对顺序
+TEST(RingBufferStress, MpmcDeliversEachItemOnce) {
+    const int kProducers = 4;
+    const int kConsumers = 4;
+    const int kPerProducer = 100000;
+    MpmcRingBuffer<int> q(256);
+
+    std::vector<std::atomic<int>> seen(kProducers * kPerProducer);
+    std::atomic<int> consumed{0};
+    std::atomic<bool> orderViolated{false};
+
+    std::vector<std::thread> threads;
+    for (int p = 0; p < kProducers; ++p) {
+        threads.emplace_back([&q, p] {
+            for (int i = 0; i < kPerProducer; ++i) {
+                while (!q.try_push(p * kPerProducer + i)) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+    for (int c = 0; c < kConsumers; ++c) {
+        threads.emplace_back([&] {
+            std::vector<int> last(kProducers, -1);
+            int v;
+            while (consumed.load() < kProducers * kPerProducer) {
+                if (!q.try_pop(v)) {
+                    std::this_thread::yield();
+                    continue;
+                }
+                seen[v].fetch_add(1);
+                int p = v / kPerProducer;
+                if (v <= last[p]) {
+                    orderViolated = true;
+                }
+                last[p] = v;
+                consumed.fetch_add(1);
+            }
+        });
+    }
+    for (auto &t : threads) {
+        t.join();
+    }
+
+    EXPECT_FALSE(orderViolated.load());
+    for (size_t i = 0; i < seen.size(); ++i) {
+        ASSERT_EQ(seen[i].load(), 1) << "item " << i;
+    }
+    EXPECT_TRUE(q.empty());
+}
@@ -0,0 +1,173 @@
+#include "String.h"
+#include <cstring>
+#include <functional>
+
+constexpr size_t String::kLocalCapacity;
+
+String::String() noexcept
+: _data(_local)
+{
+    _local[0] = '\0';
+}
+
+String::String(const char *str)
+: String(str, str ? std::strlen(str) : 0)
+{}
+
+String::String(const char *str, size_t len)
+: _data(_local)
+{
+    _local[0] = '\0';
+    assign(str, len);
+}
+
+String::String(const String &other)
+: String(other._data, other._size)
+{}
+
+String::String(String &&other) noexcept
+{
+    moveFrom(other);
+}
+
+String::~String()
+{
+    if (!isLocal()) {
+        delete[] _data;
+    }
+}
+
+String &String::operator=(const String &rhs)
+{
+    if (this != &rhs) {
+        assign(rhs._data, rhs._size);
+    }
+    return *this;
+}
+
+String &String::operator=(String &&rhs) noexcept
+{
+    if (this != &rhs) {
+        if (!isLocal()) {
+            delete[] _data;
+        }
+        moveFrom(rhs);
+    }
+    return *this;
+}
+
+String &String::operator=(const char *str)
+{
+    assign(str, str ? std::strlen(str) : 0);
+    return *this;
+}
+
+// str 可以指向自身内部（例如 s.append(s.c_str())），扩容后要换算到新内存上
+String &String::append(const char *str, size_t len)
+{
+    if (len == 0) {
+        return *this;
+    }
+    if (_size + len > capacity()) {
+        std::less_equal<const char *> le;
+        bool inside = le(_data, str) && le(str, _data + _size);
+        size_t offset = inside ? static_cast<size_t>(str - _data) : 0;
+        grow(_size + len);
+        if (inside) {
+            str = _data + offset;
+        }
+    }
+    std::memmove(_data + _size, str, len);
+    _size += len;
+    _data[_size] = '\0';
+    return *this;
+}
+
+String &String::append(const char *str)
+{
+    return str ? append(str, std::strlen(str)) : *this;
+}
+
+void String::push_back(char c)
+{
+    append(&c, 1);
+}
+
+void String::reserve(size_t cap)
+{
+    if (cap > capacity()) {
+        grow(cap);
+    }
+}
+
+void String::clear() noexcept
+{
+    _size = 0;
+    _data[0] = '\0';
+}
+
+void String::swap(String &other) noexcept
+{
+    String tmp(static_cast<String &&>(other));
+    other = static_cast<String &&>(*this);
+    *this = static_cast<String &&>(tmp);
+}
+
+// 容量足够时复用现有内存（str 可能指向自身内部，所以用 memmove），否则重新分配
+void String::assign(const char *str, size_t len)
+{
+    if (len > capacity()) {
+        size_t cap = len;
+        char *p = new char[cap + 1];
+        if (!isLocal()) {
+            delete[] _data;
+        }
+        _data = p;
+        _capacity = cap;
+    }
+    if (len) {
+        std::memmove(_data, str, len);
+    }
+    _size = len;
+    _data[_size] = '\0';
+}
+
+void String::grow(size_t needed)
+{
+    size_t cap = capacity() * 2;
+    if (cap < needed) {
+        cap = needed;
+    }
+    char *p = new char[cap + 1];
+    std::memcpy(p, _data, _size + 1);
+    if (!isLocal()) {
+        delete[] _data;
+    }
+    _data = p;
+    _capacity = cap;
+}
+
+void String::moveFrom(String &other) noexcept
+{
+    _size = other._size;
+    if (other.isLocal()) {
+        _data = _local;
+        std::memcpy(_local, other._local, other._size + 1);
+    } else {
+        _data = other._data;
+        _capacity = other._capacity;
+        other._data = other._local;
+    }
+    other._size = 0;
+    other._local[0] = '\0';
+}
+
+bool operator==(const String &lhs, const String &rhs)
+{
+    return lhs._size == rhs._size && std::memcmp(lhs._data, rhs._data, lhs._size) == 0;
+}
+
+std::ostream &operator<<(std::ostream &os, const String &s)
+{
+    return os.write(s._data, static_cast<std::streamsize>(s._size));
+}
@@ -0,0 +1,67 @@
+#ifndef __STRING_H__
+#define __STRING_H__
+
+#include <cstddef>
+#include <ostream>
+
+// 由笔记中的 String（Interview/3_面向对象.md）演变而来
+// - 短字符串（不超过 15 个字符）直接存放在对象内部，不分配堆内存（SSO）
+// - 移动构造/移动赋值只转移指针，noexcept
+// - 记录容量，追加时按 2 倍扩容，均摊 O(1)
+// - _data 始终指向以 '\0' 结尾的有效内存，空字符串也一样
+class String
+{
+public:
+    static constexpr size_t kLocalCapacity = 15;
+
+    String() noexcept;
+    String(const char *str);
+    String(const char *str, size_t len);
+    String(const String &other);
+    String(String &&other) noexcept;
+    ~String();
+
+    String &operator=(const String &rhs);
+    String &operator=(String &&rhs) noexcept;
+    String &operator=(const char *str);
+
+    String &append(const char *str, size_t len);
+    String &append(const char *str);
+    String &append(const String &other) { return append(other._data, other._size); }
+    String &operator+=(const String &other) { return append(other); }
+    String &operator+=(const char *str) { return append(str); }
+    void push_back(char c);
+
+    void reserve(size_t capacity);
+    void clear() noexcept;
+    void swap(String &other) noexcept;
+
+    const char *c_str() const noexcept { return _data; }
+    const char *data() const noexcept { return _data; }
+    size_t size() const noexcept { return _size; }
+    size_t capacity() const noexcept { return isLocal() ? kLocalCapacity : _capacity; }
+    bool empty() const noexcept { return _size == 0; }
+    bool isLocal() const noexcept { return _data == _local; }
+
+    char &operator[](size_t i) { return _data[i]; }
+    char operator[](size_t i) const { return _data[i]; }
+
+    friend bool operator==(const String &lhs, const String &rhs);
+    friend bool operator!=(const String &lhs, const String &rhs) { return !(lhs == rhs); }
+    friend std::ostream &operator<<(std::ostream &os, const String &s);
+
+private:
+    void assign(const char *str, size_t len);
+    void grow(size_t needed);
+    void moveFrom(String &other) noexcept;
+
+    char *_data;
+    size_t _size = 0;
+    union
+    {
+        char _local[kLocalCapacity + 1];
+        size_t _capacity;
+    };
+};
+
+#endif
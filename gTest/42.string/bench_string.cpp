@@ -0,0 +1,68 @@
+#include "String.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <utility>
+#include <vector>
+
+// 与 std::string 对比构造、拷贝、移动和追加的开销，短串（SSO 内）和长串分别测试
+// 用法：bench_string [次数，默认 2000000]
+
+template <typename Func>
+double timeIt(Func func)
+{
+    auto start = std::chrono::steady_clock::now();
+    func();
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+template <typename Str>
+void run(const char *name, const char *payload, size_t n)
+{
+    size_t sink = 0;
+    double construct = timeIt([&] {
+        for (size_t i = 0; i < n; ++i) {
+            Str s(payload);
+            sink += s.size();
+        }
+    });
+    Str source(payload);
+    double copy = timeIt([&] {
+        for (size_t i = 0; i < n; ++i) {
+            Str s(source);
+            sink += s.size();
+        }
+    });
+    std::vector<Str> pool(n, Str(payload));
+    double move = timeIt([&] {
+        for (size_t i = 0; i < n; ++i) {
+            Str s(std::move(pool[i]));
+            sink += s.size();
+        }
+    });
+    double append = timeIt([&] {
+        Str s;
+        for (size_t i = 0; i < n; ++i) {
+            s += payload;
+        }
+        sink += s.size();
+    });
+    std::printf("%-12s construct %6.1f ns  copy %6.1f ns  move %6.1f ns  append %6.1f ns  (%zu)\n",
+                name, construct * 1e9 / n, copy * 1e9 / n, move * 1e9 / n, append * 1e9 / n, sink);
+}
+
+int main(int argc, char **argv)
+{
+    size_t n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 2000000;
+    const char *shortPayload = "hello, world";
+    const char *longPayload = "a log line that is long enough to live on the heap";
+
+    std::printf("short payload (%zu chars)\n", std::char_traits<char>::length(shortPayload));
+    run<String>("String", shortPayload, n);
+    run<std::string>("std::string", shortPayload, n);
+    std::printf("long payload (%zu chars)\n", std::char_traits<char>::length(longPayload));
+    run<String>("String", longPayload, n);
+    run<std::string>("std::string", longPayload, n);
+    return 0;
+}
@@ -0,0 +1,154 @@
+#include "String.h"
+#include <gtest/gtest.h>
+#include <sstream>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+static_assert(std::is_nothrow_move_constructible<String>::value, "String move ctor must be noexcept");
+static_assert(std::is_nothrow_move_assignable<String>::value, "String move assignment must be noexcept");
+
+void PrintTo(const String &s, std::ostream *os) {
+    *os << '"' << s << '"';
+}
+
+static const char *kLong = "this string is definitely longer than fifteen characters";
+
+TEST(StringTest, EmptyAndShortStayInline) {
+    String empty;
+    EXPECT_TRUE(empty.empty());
+    EXPECT_TRUE(empty.isLocal());
+    EXPECT_STREQ(empty.c_str(), "");
+
+    String null(nullptr);
+    EXPECT_TRUE(null.isLocal());
+    EXPECT_STREQ(null.c_str(), "");
+
+    String fifteen("123456789012345");
+    EXPECT_TRUE(fifteen.isLocal());
+    EXPECT_EQ(fifteen.size(), 15);
+    EXPECT_EQ(fifteen.capacity(), String::kLocalCapacity);
+
+    String sixteen("1234567890123456");
+    EXPECT_FALSE(sixteen.isLocal());
+    EXPECT_STREQ(sixteen.c_str(), "1234567890123456");
+}
+
+TEST(StringTest, CopyIsDeep) {
+    for (const char *text : {"short", kLong}) {
+        String a(text);
+        String b(a);
+        EXPECT_EQ(a, b);
+        EXPECT_NE(a.c_str(), b.c_str());
+        b[0] = 'X';
+        EXPECT_STREQ(a.c_str(), text);
+    }
+}
+
+TEST(StringTest, MoveStealsHeapBuffer) {
+    String a(kLong);
+    const char *buffer = a.c_str();
+    String b(std::move(a));
+    EXPECT_EQ(b.c_str(), buffer);
+    EXPECT_STREQ(b.c_str(), kLong);
+    EXPECT_TRUE(a.empty());
+    EXPECT_STREQ(a.c_str(), "");
+
+    String c("short");
+    c = std::move(b);
+    EXPECT_EQ(c.c_str(), buffer);
+    EXPECT_TRUE(b.empty());
+}
+
+TEST(StringTest, MoveInlineCopiesBytes) {
+    String a("short");
+    String b(std::move(a));
+    EXPECT_STREQ(b.c_str(), "short");
+    EXPECT_TRUE(b.isLocal());
+    EXPECT_TRUE(a.empty());
+
+    String c(kLong);
+    c = std::move(b);
+    EXPECT_STREQ(c.c_str(), "short");
+    EXPECT_TRUE(c.isLocal());
+}
+
+TEST(StringTest, AssignReusesCapacity) {
+    String s(kLong);
+    const char *buffer = s.c_str();
+    s = "tiny";
+    EXPECT_EQ(s.c_str(), buffer);
+    EXPECT_STREQ(s.c_str(), "tiny");
+
+    String other("another fairly long string value");
+    s = other;
+    EXPECT_EQ(s, other);
+}
+
+TEST(StringTest, SelfAssignment) {
+    for (const char *text : {"short", kLong}) {
+        String s(text);
+        String &ref = s;
+        s = ref;
+        EXPECT_STREQ(s.c_str(), text);
+        s = std::move(ref);
+        EXPECT_STREQ(s.c_str(), text);
+        s = s.c_str() + 1;
+        EXPECT_STREQ(s.c_str(), text + 1);
+    }
+}
+
+TEST(StringTest, AppendGrowsGeometrically) {
+    String s;
+    size_t reallocations = 0;
+    const char *buffer = s.c_str();
+    std::string expected;
+    for (int i = 0; i < 10000; ++i) {
+        s.push_back(static_cast<char>('a' + i % 26));
+        expected.push_back(static_cast<char>('a' + i % 26));
+        if (s.c_str() != buffer) {
+            ++reallocations;
+            buffer = s.c_str();
+        }
+    }
+    EXPECT_EQ(std::string(s.c_str(), s.size()), expected);
+    EXPECT_LE(reallocations, 10);
+    EXPECT_GE(s.capacity(), s.size());
+}
+
+TEST(StringTest, AppendSelf) {
+    String s("abc");
+    s.append(s);
+    EXPECT_STREQ(s.c_str(), "abcabc");
+    s += s.c_str();
+    s += s;
+    EXPECT_STREQ(s.c_str(), "abcabcabcabcabcabcabcabc");
+    EXPECT_EQ(s.size(), 24);
+}
+
+TEST(StringTest, ReserveAndClear) {
+    String s("abc");
+    s.reserve(100);
+    EXPECT_GE(s.capacity(), 100);
+    EXPECT_STREQ(s.c_str(), "abc");
+    s.clear();
+    EXPECT_TRUE(s.empty());
+    EXPECT_GE(s.capacity(), 100);
+}
+
+TEST(StringTest, Swap) {
+    String a("short");
+    String b(kLong);
+    a.swap(b);
+    EXPECT_STREQ(a.c_str(), kLong);
+    EXPECT_STREQ(b.c_str(), "short");
+}
+
+TEST(StringTest, EmbeddedNulAndStream) {
+    String s("a\0b", 3);
+    EXPECT_EQ(s.size(), 3);
+    EXPECT_NE(s, String("a"));
+    std::ostringstream os;
+    os << String("hello");
+    EXPECT_EQ(os.str(), "hello");
+}
@@ -0,0 +1,195 @@
+#include "arena.h"
+#include "pool.h"
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <list>
+#include <memory_resource>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+static bool IsAligned(const void *p, size_t align)
+{
+    return reinterpret_cast<uintptr_t>(p) % align == 0;
+}
+
+TEST(ArenaTest, BumpAllocationIsAlignedAndContiguous)
+{
+    Arena arena;
+    char *a = static_cast<char *>(arena.allocate(8, 8));
+    char *b = static_cast<char *>(arena.allocate(8, 8));
+    EXPECT_EQ(b, a + 8);
+
+    arena.allocate(1, 1);
+    void *c = arena.allocate(32, 64);
+    EXPECT_TRUE(IsAligned(c, 64));
+    EXPECT_GE(arena.bytesUsed(), 8 + 8 + 1 + 32);
+}
+
+TEST(ArenaTest, ResetReusesBlocks)
+{
+    Arena arena(ArenaOptions {4096, false});
+    void *first = arena.allocate(100);
+    for (int i = 0; i < 100; ++i) {
+        arena.allocate(1000);
+    }
+    size_t blocks = arena.blockCount();
+    EXPECT_GT(blocks, 1);
+
+    arena.reset();
+    EXPECT_EQ(arena.bytesUsed(), 0);
+    EXPECT_EQ(arena.allocate(100), first);
+    for (int i = 0; i < 100; ++i) {
+        arena.allocate(1000);
+    }
+    EXPECT_EQ(arena.blockCount(), blocks);
+}
+
+TEST(ArenaTest, ScopeRewindsAllocations)
+{
+    Arena arena(ArenaOptions {4096, false});
+    arena.allocate(64);
+    size_t before = arena.bytesUsed();
+    void *next = nullptr;
+    {
+        ArenaScope scope(arena);
+        next = arena.allocate(16);
+        for (int i = 0; i < 20; ++i) {
+            arena.allocate(1000);
+        }
+        arena.allocate(100000);
+        EXPECT_GT(arena.bytesUsed(), before + 100000);
+    }
+    EXPECT_EQ(arena.bytesUsed(), before);
+    EXPECT_EQ(arena.allocate(16), next);
+}
+
+TEST(ArenaTest, LargeAllocationGetsOwnBlock)
+{
+    Arena arena(ArenaOptions {4096, false});
+    char *big = static_cast<char *>(arena.allocate(1 << 20, 128));
+    EXPECT_TRUE(IsAligned(big, 128));
+    big[0] = 1;
+    big[(1 << 20) - 1] = 1;
+    EXPECT_EQ(arena.blockCount(), 1);
+}
+
+TEST(ArenaTest, HugePageBackedArena)
+{
+    Arena arena(ArenaOptions {4 * 1024 * 1024, true});
+    EXPECT_TRUE(arena.hugePages());
+    char *p = static_cast<char *>(arena.allocate(3 * 1024 * 1024));
+    p[0] = 1;
+    p[3 * 1024 * 1024 - 1] = 1;
+    arena.reset();
+    EXPECT_EQ(arena.allocate(16), p);
+}
+
+TEST(ArenaTest, AsPmrResource)
+{
+    Arena arena;
+    {
+        std::pmr::vector<std::pmr::string> names(&arena);
+        for (int i = 0; i < 100; ++i) {
+            names.emplace_back("a name long enough to skip the small string buffer");
+        }
+        EXPECT_EQ(names.size(), 100);
+        EXPECT_EQ(names.get_allocator().resource(), &arena);
+    }
+    EXPECT_GT(arena.bytesUsed(), 100 * 50);
+}
+
+TEST(ArenaTest, ThreadLocalArenaIsPerThread)
+{
+    Arena *main = &threadLocalArena();
+    Arena *other = nullptr;
+    std::thread t([&other] { other = &threadLocalArena(); });
+    t.join();
+    EXPECT_EQ(&threadLocalArena(), main);
+    EXPECT_NE(other, main);
+}
+
+TEST(PoolTest, SizeClasses)
+{
+    EXPECT_EQ(PoolResource::classOf(1, 1), 0);
+    EXPECT_EQ(PoolResource::classOf(8, 8), 0);
+    EXPECT_EQ(PoolResource::classOf(9, 8), 1);
+    EXPECT_EQ(PoolResource::classOf(24, 8), 2);
+    EXPECT_EQ(PoolResource::classOf(8, 64), 3);
+    EXPECT_EQ(PoolResource::classOf(1024, 8), 7);
+    EXPECT_EQ(PoolResource::classOf(1025, 8), PoolResource::kClassCount);
+}
+
+TEST(PoolTest, FreedSlotIsReused)
+{
+    FixedPool pool(48, 4);
+    void *a = pool.allocate();
+    void *b = pool.allocate();
+    EXPECT_EQ(static_cast<char *>(b) - static_cast<char *>(a), 48);
+    pool.deallocate(a);
+    EXPECT_EQ(pool.allocate(), a);
+    EXPECT_EQ(pool.inUse(), 2);
+
+    std::set<void *> seen {a, b};
+    for (int i = 0; i < 10; ++i) {
+        EXPECT_TRUE(seen.insert(pool.allocate()).second);
+    }
+    EXPECT_EQ(pool.chunkCount(), 3);
+}
+
+TEST(PoolTest, AllocationsRespectAlignment)
+{
+    PoolResource pool;
+    for (size_t align : {1, 2, 4, 8, 16, 32, 64}) {
+        for (size_t size : {1, 7, 24, 100, 1000}) {
+            void *p = pool.allocate(size, align);
+            EXPECT_TRUE(IsAligned(p, align)) << "size " << size << " align " << align;
+            pool.deallocate(p, size, align);
+        }
+    }
+    void *big = pool.allocate(4096, 8);
+    EXPECT_NE(big, nullptr);
+    pool.deallocate(big, 4096, 8);
+}
+
+TEST(PoolTest, AsPmrResource)
+{
+    PoolResource pool;
+    {
+        std::pmr::list<int> values(&pool);
+        for (int i = 0; i < 1000; ++i) {
+            values.push_back(i);
+        }
+        EXPECT_GT(pool.pool(PoolResource::classOf(sizeof(int) + 2 * sizeof(void *), 8)).inUse(), 999);
+    }
+    for (size_t c = 0; c < PoolResource::kClassCount; ++c) {
+        EXPECT_EQ(pool.pool(c).inUse(), 0) << "class " << c;
+    }
+}
+
+// 40.free_obj 中 new 出来的 MockCalc 改为从池里分配
+class Calc
+{
+public:
+    virtual int calc(int a, int b) = 0;
+    virtual ~Calc() = default;
+};
+
+class MockCalc : public Calc
+{
+public:
+    MOCK_METHOD(int, calc, (int a, int b), (override));
+};
+
+TEST(PoolTest, PlacementNewMock)
+{
+    PoolResource &pool = threadLocalPool();
+    MockCalc *pmc = pool.create<MockCalc>();
+    EXPECT_CALL(*pmc, calc(2, 3))
+        .WillOnce(::testing::Return(5));
+    Calc *c = pmc;
+    EXPECT_EQ(5, c->calc(2, 3));
+    pool.destroy(pmc);
+}
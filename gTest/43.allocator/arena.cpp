@@ -0,0 +1,109 @@
+#include "arena.h"
+#include <cstdlib>
+#include <sys/mman.h>
+
+static const size_t kHugePageSize = 2 * 1024 * 1024;
+
+Arena::Arena(ArenaOptions options)
+: _options(options)
+{
+    if (_options.blockSize < 4096) {
+        _options.blockSize = 4096;
+    }
+    _blocks.push_back(newBlock(_options.blockSize));
+}
+
+Arena::~Arena()
+{
+    for (Block &b : _blocks) {
+        freeBlock(b);
+    }
+    for (Block &b : _large) {
+        freeBlock(b);
+    }
+}
+
+Arena::Marker Arena::mark() const
+{
+    return Marker {_current, _blocks[_current].used, _large.size()};
+}
+
+void Arena::rewind(const Marker &marker)
+{
+    for (size_t i = marker.block + 1; i <= _current; ++i) {
+        _blocks[i].used = 0;
+    }
+    _current = marker.block;
+    _blocks[_current].used = marker.used;
+    while (_large.size() > marker.large) {
+        freeBlock(_large.back());
+        _large.pop_back();
+    }
+}
+
+size_t Arena::bytesUsed() const
+{
+    size_t n = 0;
+    for (size_t i = 0; i <= _current; ++i) {
+        n += _blocks[i].used;
+    }
+    for (const Block &b : _large) {
+        n += b.used;
+    }
+    return n;
+}
+
+// 当前块放不下：超大请求单独申请一块；否则切到下一块（rewind 之后保留的块优先复用）
+void *Arena::allocateSlow(size_t size, size_t align)
+{
+    if (size + align > _options.blockSize) {
+        Block b = newBlock(size + align);
+        size_t offset = (align - reinterpret_cast<uintptr_t>(b.data) % align) % align;
+        b.used = offset + size;
+        _large.push_back(b);
+        return b.data + offset;
+    }
+    if (_current + 1 == _blocks.size()) {
+        _blocks.push_back(newBlock(_options.blockSize));
+    }
+    ++_current;
+    return allocate(size, align);
+}
+
+Arena::Block Arena::newBlock(size_t size)
+{
+    if (_options.hugePages) {
+        size = (size + kHugePageSize - 1) / kHugePageSize * kHugePageSize;
+        void *p = ::mmap(nullptr, size, PROT_READ | PROT_WRITE,
+                         MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+        if (p == MAP_FAILED) {
+            p = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            if (p == MAP_FAILED) {
+                throw std::bad_alloc();
+            }
+            ::madvise(p, size, MADV_HUGEPAGE);
+        }
+        return Block {static_cast<char *>(p), size, 0, true};
+    }
+    void *p = std::malloc(size);
+    if (!p) {
+        throw std::bad_alloc();
+    }
+    return Block {static_cast<char *>(p), size, 0, false};
+}
+
+void Arena::freeBlock(Block &b)
+{
+    if (b.mapped) {
+        ::munmap(b.data, b.size);
+    } else {
+        std::free(b.data);
+    }
+    b.data = nullptr;
+}
+
+Arena &threadLocalArena()
+{
+    thread_local Arena arena;
+    return arena;
+}
@@ -0,0 +1,114 @@
+#ifndef __ARENA_H__
+#define __ARENA_H__
+
+#include <cstddef>
+#include <cstdint>
+#include <memory_resource>
+#include <new>
+#include <utility>
+#include <vector>
+
+struct ArenaOptions
+{
+    size_t blockSize = 64 * 1024;
+    // 用 2MB 大页做后备内存：优先 MAP_HUGETLB，失败则退回普通 mmap + MADV_HUGEPAGE
+    bool hugePages = false;
+};
+
+// 单调递增（bump）分配器：分配只是移动指针，单个对象不能释放，只能整体 reset 或按作用域回退
+// 不是线程安全的，多线程请使用 threadLocalArena()
+// 同时是一个 std::pmr::memory_resource，可以直接给 pmr 容器使用
+class Arena : public std::pmr::memory_resource
+{
+public:
+    // 某一时刻的分配位置，rewind 回到这里时，之后分配的内存全部作废
+    struct Marker
+    {
+        size_t block;
+        size_t used;
+        size_t large;
+    };
+
+    explicit Arena(ArenaOptions options = ArenaOptions());
+    ~Arena() override;
+
+    Arena(const Arena &) = delete;
+    Arena &operator=(const Arena &) = delete;
+
+    void *allocate(size_t size, size_t align = alignof(std::max_align_t))
+    {
+        Block &b = _blocks[_current];
+        uintptr_t base = reinterpret_cast<uintptr_t>(b.data);
+        size_t offset = ((base + b.used + align - 1) & ~(align - 1)) - base;
+        if (offset + size <= b.size) {
+            b.used = offset + size;
+            return b.data + offset;
+        }
+        return allocateSlow(size, align);
+    }
+
+    // placement new 构造对象；析构函数不会被自动调用
+    template <typename T, typename... Args>
+    T *create(Args &&...args)
+    {
+        return new (allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+    }
+
+    Marker mark() const;
+    void rewind(const Marker &marker);
+    // 回到初始状态，已申请的块保留下来供后续复用
+    void reset() { rewind(Marker {0, 0, 0}); }
+
+    // 当前仍有效的字节数（含对齐填充）
+    size_t bytesUsed() const;
+    size_t blockCount() const { return _blocks.size(); }
+    bool hugePages() const { return _options.hugePages; }
+
+private:
+    struct Block
+    {
+        char *data;
+        size_t size;
+        size_t used;
+        bool mapped;
+    };
+
+    void *do_allocate(size_t size, size_t align) override { return allocate(size, align); }
+    void do_deallocate(void *, size_t, size_t) override {}
+    bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override
+    {
+        return this == &other;
+    }
+
+    void *allocateSlow(size_t size, size_t align);
+    Block newBlock(size_t size);
+    void freeBlock(Block &b);
+
+    ArenaOptions _options;
+    std::vector<Block> _blocks;
+    std::vector<Block> _large;
+    size_t _current = 0;
+};
+
+// 作用域内分配的内存在离开作用域时整体回收
+class ArenaScope
+{
+public:
+    explicit ArenaScope(Arena &arena)
+    : _arena(arena)
+    , _marker(arena.mark())
+    {}
+    ~ArenaScope() { _arena.rewind(_marker); }
+
+    ArenaScope(const ArenaScope &) = delete;
+    ArenaScope &operator=(const ArenaScope &) = delete;
+
+private:
+    Arena &_arena;
+    Arena::Marker _marker;
+};
+
+// 每个线程一个 Arena，第一次调用时创建
+Arena &threadLocalArena();
+
+#endif
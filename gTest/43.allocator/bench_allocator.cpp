@@ -0,0 +1,92 @@
+#include "arena.h"
+#include "pool.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+// 小对象分配/释放的抖动场景：每轮分配 kBatch 个 16~256 字节的对象，再全部释放
+// 对比 malloc/free、线程局部 PoolResource、线程局部 Arena（作用域整体回收），线程数 1/4/16
+// 用法：bench_allocator [每个线程的轮数，默认 2000]
+
+static const size_t kBatch = 1000;
+
+static size_t sizeAt(size_t i)
+{
+    return 16 + (i * 37) % 241;
+}
+
+struct MallocAlloc
+{
+    static void round(std::vector<void *> &ptrs)
+    {
+        for (size_t i = 0; i < kBatch; ++i) {
+            ptrs[i] = std::malloc(sizeAt(i));
+            static_cast<char *>(ptrs[i])[0] = 1;
+        }
+        for (size_t i = 0; i < kBatch; ++i) {
+            std::free(ptrs[i]);
+        }
+    }
+};
+
+struct PoolAlloc
+{
+    static void round(std::vector<void *> &ptrs)
+    {
+        PoolResource &pool = threadLocalPool();
+        for (size_t i = 0; i < kBatch; ++i) {
+            ptrs[i] = pool.allocate(sizeAt(i));
+            static_cast<char *>(ptrs[i])[0] = 1;
+        }
+        for (size_t i = 0; i < kBatch; ++i) {
+            pool.deallocate(ptrs[i], sizeAt(i));
+        }
+    }
+};
+
+struct ArenaAlloc
+{
+    static void round(std::vector<void *> &ptrs)
+    {
+        Arena &arena = threadLocalArena();
+        ArenaScope scope(arena);
+        for (size_t i = 0; i < kBatch; ++i) {
+            ptrs[i] = arena.allocate(sizeAt(i));
+            static_cast<char *>(ptrs[i])[0] = 1;
+        }
+    }
+};
+
+template <typename Alloc>
+void run(const char *name, int threads, int rounds)
+{
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; ++t) {
+        workers.emplace_back([rounds] {
+            std::vector<void *> ptrs(kBatch);
+            for (int r = 0; r < rounds; ++r) {
+                Alloc::round(ptrs);
+            }
+        });
+    }
+    for (auto &w : workers) {
+        w.join();
+    }
+    double s = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    double ops = static_cast<double>(threads) * rounds * kBatch;
+    std::printf("%-8s %2d threads  %8.3f s  %8.2f Mallocs/s\n", name, threads, s, ops / s / 1e6);
+}
+
+int main(int argc, char **argv)
+{
+    int rounds = argc > 1 ? std::atoi(argv[1]) : 2000;
+    for (int threads : {1, 4, 16}) {
+        run<MallocAlloc>("malloc", threads, rounds);
+        run<PoolAlloc>("pool", threads, rounds);
+        run<ArenaAlloc>("arena", threads, rounds);
+    }
+    return 0;
+}
@@ -0,0 +1,53 @@
+#include "pool.h"
+
+FixedPool::FixedPool(size_t slotSize, size_t slotsPerChunk)
+: _slotSize(slotSize < sizeof(FreeSlot) ? sizeof(FreeSlot) : slotSize)
+, _slotsPerChunk(slotsPerChunk ? slotsPerChunk : 1)
+{}
+
+FixedPool::~FixedPool()
+{
+    for (void *chunk : _chunks) {
+        ::operator delete(chunk, std::align_val_t(alignment()));
+    }
+}
+
+size_t FixedPool::alignment() const
+{
+    size_t align = alignof(std::max_align_t);
+    while (align < _slotSize && align < 4096 && _slotSize % (align * 2) == 0) {
+        align *= 2;
+    }
+    return align;
+}
+
+// 新 chunk 里的槽位按地址顺序串起来，先分配出去的是低地址
+void FixedPool::refill()
+{
+    char *chunk = static_cast<char *>(
+        ::operator new(_slotSize * _slotsPerChunk, std::align_val_t(alignment())));
+    _chunks.push_back(chunk);
+    for (size_t i = _slotsPerChunk; i-- > 0;) {
+        FreeSlot *slot = reinterpret_cast<FreeSlot *>(chunk + i * _slotSize);
+        slot->next = _free;
+        _free = slot;
+    }
+}
+
+constexpr size_t PoolResource::kMinClass;
+constexpr size_t PoolResource::kMaxClass;
+constexpr size_t PoolResource::kClassCount;
+
+PoolResource::PoolResource(std::pmr::memory_resource *upstream)
+: _upstream(upstream)
+{
+    for (size_t c = 0; c < kClassCount; ++c) {
+        _pools[c].reset(new FixedPool(kMinClass << c));
+    }
+}
+
+PoolResource &threadLocalPool()
+{
+    thread_local PoolResource pool;
+    return pool;
+}
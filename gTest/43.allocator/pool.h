@@ -0,0 +1,137 @@
+#ifndef __POOL_H__
+#define __POOL_H__
+
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <new>
+#include <utility>
+#include <vector>
+
+// 定长对象池：按 chunk 批量申请内存，切成等长的槽位，空闲槽位串成单链表
+// slotSize 为 2 的幂时，每个槽位都按 slotSize 对齐
+// 分配和释放都是 O(1) 的链表头操作，不是线程安全的
+class FixedPool
+{
+public:
+    explicit FixedPool(size_t slotSize, size_t slotsPerChunk = 256);
+    ~FixedPool();
+
+    FixedPool(const FixedPool &) = delete;
+    FixedPool &operator=(const FixedPool &) = delete;
+
+    void *allocate()
+    {
+        if (!_free) {
+            refill();
+        }
+        FreeSlot *slot = _free;
+        _free = slot->next;
+        ++_inUse;
+        return slot;
+    }
+
+    void deallocate(void *p)
+    {
+        FreeSlot *slot = static_cast<FreeSlot *>(p);
+        slot->next = _free;
+        _free = slot;
+        --_inUse;
+    }
+
+    size_t slotSize() const { return _slotSize; }
+    size_t inUse() const { return _inUse; }
+    size_t chunkCount() const { return _chunks.size(); }
+
+private:
+    struct FreeSlot
+    {
+        FreeSlot *next;
+    };
+
+    void refill();
+    size_t alignment() const;
+
+    size_t _slotSize;
+    size_t _slotsPerChunk;
+    FreeSlot *_free = nullptr;
+    size_t _inUse = 0;
+    std::vector<void *> _chunks;
+};
+
+// 按大小分级的对象池：8、16、32 ... 1024 字节各一个 FixedPool，更大的请求交给 upstream
+// 同一块内存必须由分配它的线程释放；多线程请使用 threadLocalPool()
+class PoolResource : public std::pmr::memory_resource
+{
+public:
+    static constexpr size_t kMinClass = 8;
+    static constexpr size_t kMaxClass = 1024;
+    static constexpr size_t kClassCount = 8;
+
+    explicit PoolResource(std::pmr::memory_resource *upstream = std::pmr::new_delete_resource());
+
+    void *allocate(size_t size, size_t align = alignof(std::max_align_t))
+    {
+        size_t c = classOf(size, align);
+        return c < kClassCount ? _pools[c]->allocate() : _upstream->allocate(size, align);
+    }
+
+    void deallocate(void *p, size_t size, size_t align = alignof(std::max_align_t))
+    {
+        size_t c = classOf(size, align);
+        if (c < kClassCount) {
+            _pools[c]->deallocate(p);
+        } else {
+            _upstream->deallocate(p, size, align);
+        }
+    }
+
+    template <typename T, typename... Args>
+    T *create(Args &&...args)
+    {
+        return new (allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+    }
+
+    template <typename T>
+    void destroy(T *p)
+    {
+        p->~T();
+        deallocate(p, sizeof(T), alignof(T));
+    }
+
+    // 请求大小对应的分级下标，超出分级返回 kClassCount
+    // 槽位按自身大小对齐，所以把对齐要求也折算进大小
+    static size_t classOf(size_t size, size_t align)
+    {
+        if (size < align) {
+            size = align;
+        }
+        if (size > kMaxClass) {
+            return kClassCount;
+        }
+        size_t c = 0;
+        size_t cap = kMinClass;
+        while (cap < size) {
+            cap <<= 1;
+            ++c;
+        }
+        return c;
+    }
+
+    const FixedPool &pool(size_t c) const { return *_pools[c]; }
+
+private:
+    void *do_allocate(size_t size, size_t align) override { return allocate(size, align); }
+    void do_deallocate(void *p, size_t size, size_t align) override { deallocate(p, size, align); }
+    bool do_is_equal(const std::pmr::memory_resource &other) const noexcept override
+    {
+        return this == &other;
+    }
+
+    std::pmr::memory_resource *_upstream;
+    std::unique_ptr<FixedPool> _pools[kClassCount];
+};
+
+PoolResource &threadLocalPool();
+
+#endif
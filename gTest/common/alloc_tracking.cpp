@@ -0,0 +1,191 @@
+#include "alloc_tracking.h"
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <malloc.h>
+#include <new>
+
+namespace {
+
+std::atomic<size_t> g_allocs {0};
+std::atomic<size_t> g_frees {0};
+std::atomic<size_t> g_bytes {0};
+std::atomic<size_t> g_live {0};
+std::atomic<size_t> g_peak {0};
+
+// 只用平凡类型，避免线程局部变量在 operator new 里触发动态初始化
+thread_local size_t t_allocs = 0;
+thread_local size_t t_frees = 0;
+thread_local size_t t_bytes = 0;
+
+void recordAlloc(void *p)
+{
+    size_t size = malloc_usable_size(p);
+    g_allocs.fetch_add(1, std::memory_order_relaxed);
+    g_bytes.fetch_add(size, std::memory_order_relaxed);
+    size_t live = g_live.fetch_add(size, std::memory_order_relaxed) + size;
+    size_t peak = g_peak.load(std::memory_order_relaxed);
+    while (live > peak && !g_peak.compare_exchange_weak(peak, live, std::memory_order_relaxed)) {
+    }
+    ++t_allocs;
+    t_bytes += size;
+}
+
+void recordFree(void *p)
+{
+    if (!p) {
+        return;
+    }
+    g_frees.fetch_add(1, std::memory_order_relaxed);
+    g_live.fetch_sub(malloc_usable_size(p), std::memory_order_relaxed);
+    ++t_frees;
+}
+
+void *trackedAlloc(size_t size)
+{
+    void *p = std::malloc(size ? size : 1);
+    if (p) {
+        recordAlloc(p);
+    }
+    return p;
+}
+
+#if __cpp_aligned_new
+// 只有对齐版本的 operator new 会用到，C++14 下没有
+void *trackedAlignedAlloc(size_t size, size_t align)
+{
+    void *p = nullptr;
+    if (posix_memalign(&p, align < sizeof(void *) ? sizeof(void *) : align, size ? size : 1) != 0) {
+        return nullptr;
+    }
+    recordAlloc(p);
+    return p;
+}
+#endif
+
+void trackedFree(void *p)
+{
+    recordFree(p);
+    std::free(p);
+}
+
+}
+
+AllocStats AllocStats::global()
+{
+    return AllocStats {g_allocs.load(), g_frees.load(), g_bytes.load(), g_live.load(), g_peak.load()};
+}
+
+AllocStats AllocStats::thisThread()
+{
+    return AllocStats {t_allocs, t_frees, t_bytes, 0, 0};
+}
+
+void AllocStats::resetPeak()
+{
+    g_peak.store(g_live.load());
+}
+
+void AllocationListener::OnTestStart(const ::testing::TestInfo &)
+{
+    AllocStats::resetPeak();
+    _start = AllocStats::global();
+}
+
+void AllocationListener::OnTestEnd(const ::testing::TestInfo &info)
+{
+    AllocStats end = AllocStats::global();
+    size_t allocs = end.allocs - _start.allocs;
+    size_t frees = end.frees - _start.frees;
+    std::printf("[  ALLOC   ] %s.%s: %zu allocs, %zu bytes, peak live %zu bytes\n",
+                info.test_suite_name(), info.name(), allocs, end.bytes - _start.bytes,
+                end.peakLiveBytes - _start.liveBytes);
+    if (end.liveBytes > _start.liveBytes) {
+        std::printf("[  LEAK?   ] %s.%s: %zu bytes in %zu blocks not freed\n",
+                    info.test_suite_name(), info.name(), end.liveBytes - _start.liveBytes,
+                    allocs > frees ? allocs - frees : 0);
+    }
+    std::fflush(stdout);
+}
+
+void InstallAllocationTracking()
+{
+    ::testing::UnitTest::GetInstance()->listeners().Append(new AllocationListener);
+}
+
+NoAllocScope::NoAllocScope(const char *file, int line)
+: _file(file)
+, _line(line)
+, _allocs(t_allocs)
+{}
+
+NoAllocScope::~NoAllocScope()
+{
+    size_t n = t_allocs - _allocs;
+    if (n != 0) {
+        ADD_FAILURE_AT(_file, _line) << "Expected no heap allocation in this scope, but "
+                                     << n << " allocation(s) happened";
+    }
+}
+
+void *operator new(size_t size)
+{
+    if (void *p = trackedAlloc(size)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void *operator new[](size_t size)
+{
+    return ::operator new(size);
+}
+
+void *operator new(size_t size, const std::nothrow_t &) noexcept
+{
+    return trackedAlloc(size);
+}
+
+void *operator new[](size_t size, const std::nothrow_t &) noexcept
+{
+    return trackedAlloc(size);
+}
+
+void operator delete(void *p) noexcept { trackedFree(p); }
+void operator delete[](void *p) noexcept { trackedFree(p); }
+void operator delete(void *p, size_t) noexcept { trackedFree(p); }
+void operator delete[](void *p, size_t) noexcept { trackedFree(p); }
+void operator delete(void *p, const std::nothrow_t &) noexcept { trackedFree(p); }
+void operator delete[](void *p, const std::nothrow_t &) noexcept { trackedFree(p); }
+
+#if __cpp_aligned_new
+void *operator new(size_t size, std::align_val_t align)
+{
+    if (void *p = trackedAlignedAlloc(size, static_cast<size_t>(align))) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void *operator new[](size_t size, std::align_val_t align)
+{
+    return ::operator new(size, align);
+}
+
+void *operator new(size_t size, std::align_val_t align, const std::nothrow_t &) noexcept
+{
+    return trackedAlignedAlloc(size, static_cast<size_t>(align));
+}
+
+void *operator new[](size_t size, std::align_val_t align, const std::nothrow_t &) noexcept
+{
+    return trackedAlignedAlloc(size, static_cast<size_t>(align));
+}
+
+void operator delete(void *p, std::align_val_t) noexcept { trackedFree(p); }
+void operator delete[](void *p, std::align_val_t) noexcept { trackedFree(p); }
+void operator delete(void *p, size_t, std::align_val_t) noexcept { trackedFree(p); }
+void operator delete[](void *p, size_t, std::align_val_t) noexcept { trackedFree(p); }
+void operator delete(void *p, std::align_val_t, const std::nothrow_t &) noexcept { trackedFree(p); }
+void operator delete[](void *p, std::align_val_t, const std::nothrow_t &) noexcept { trackedFree(p); }
+#endif
@@ -0,0 +1,62 @@
+#ifndef __ALLOC_TRACKING_H__
+#define __ALLOC_TRACKING_H__
+
+#include <gtest/gtest.h>
+#include <cstddef>
+
+// 堆分配统计：链接 alloc_tracking.cpp 后，全局 operator new/delete 被替换为带计数的版本
+// - AllocStats::global() 是整个进程的累计值
+// - AllocStats::thisThread() 只统计当前线程，EXPECT_NO_ALLOC 用它来判断
+struct AllocStats
+{
+    size_t allocs;
+    size_t frees;
+    size_t bytes;
+    size_t liveBytes;
+    size_t peakLiveBytes;
+
+    static AllocStats global();
+    static AllocStats thisThread();
+    // 把峰值重置为当前存活字节数，用于按测试统计峰值
+    static void resetPeak();
+};
+
+// 每个测试结束后输出一行分配统计；测试期间新增且未释放的内存标记为可能的泄漏
+// gtest 自己也会为测试结果分配内存，所以泄漏只做提示，不判定测试失败
+class AllocationListener : public ::testing::EmptyTestEventListener
+{
+public:
+    void OnTestStart(const ::testing::TestInfo &) override;
+    void OnTestEnd(const ::testing::TestInfo &info) override;
+
+private:
+    AllocStats _start {};
+};
+
+// 在 main 里 InitGoogleTest 之后调用
+void InstallAllocationTracking();
+
+// 作用域内当前线程发生任何堆分配，都记一次非致命失败
+class NoAllocScope
+{
+public:
+    NoAllocScope(const char *file, int line);
+    ~NoAllocScope();
+
+    NoAllocScope(const NoAllocScope &) = delete;
+    NoAllocScope &operator=(const NoAllocScope &) = delete;
+
+    bool once() { return _first ? (_first = false, true) : false; }
+
+private:
+    const char *_file;
+    int _line;
+    size_t _allocs;
+    bool _first = true;
+};
+
+// 用法：EXPECT_NO_ALLOC { hot_path(); }
+#define EXPECT_NO_ALLOC \
+    for (NoAllocScope no_alloc_scope_(__FILE__, __LINE__); no_alloc_scope_.once();)
+
+#endif
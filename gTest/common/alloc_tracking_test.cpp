@@ -0,0 +1,90 @@
+#include "alloc_tracking.h"
+#include "test_timing.h"
+#include <gtest/gtest.h>
+#include <gtest/gtest-spi.h>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+// 写到 volatile 里，防止编译器把成对的 new/delete 优化掉
+static void *volatile g_escape;
+
+TEST(AllocTrackingTest, CountsNewAndDelete)
+{
+    AllocStats before = AllocStats::thisThread();
+    int *p = new int(42);
+    g_escape = p;
+    std::unique_ptr<char[]> buf(new char[100]);
+    g_escape = buf.get();
+    AllocStats during = AllocStats::thisThread();
+    delete p;
+    buf.reset();
+    AllocStats after = AllocStats::thisThread();
+
+    EXPECT_EQ(during.allocs - before.allocs, 2);
+    EXPECT_GE(during.bytes - before.bytes, sizeof(int) + 100);
+    EXPECT_EQ(after.frees - before.frees, 2);
+}
+
+TEST(AllocTrackingTest, TracksPeakLiveBytes)
+{
+    AllocStats::resetPeak();
+    AllocStats before = AllocStats::global();
+    {
+        std::vector<char> big(1 << 20);
+    }
+    AllocStats after = AllocStats::global();
+    EXPECT_GE(after.peakLiveBytes - before.liveBytes, 1 << 20);
+    EXPECT_LT(after.liveBytes, before.liveBytes + (1 << 20));
+}
+
+TEST(AllocTrackingTest, OtherThreadsDoNotCount)
+{
+    EXPECT_NO_ALLOC {
+        // 线程对象本身不在这里创建，只统计当前线程
+    }
+    std::thread t([] { std::vector<int> v(1000); });
+    size_t before = AllocStats::thisThread().allocs;
+    t.join();
+    EXPECT_EQ(AllocStats::thisThread().allocs, before);
+}
+
+static int SumOnStack()
+{
+    int values[16] = {};
+    int sum = 0;
+    for (int i = 0; i < 16; ++i) {
+        values[i] = i;
+        sum += values[i];
+    }
+    return sum;
+}
+
+static void AllocatesInsideScope()
+{
+    EXPECT_NO_ALLOC {
+        std::string s(100, 'x');
+    }
+}
+
+TEST(AllocTrackingTest, NoAllocPassesWithoutHeapUse)
+{
+    int sum = 0;
+    EXPECT_NO_ALLOC {
+        sum = SumOnStack();
+    }
+    EXPECT_EQ(sum, 120);
+}
+
+TEST(AllocTrackingTest, NoAllocFailsOnHeapUse)
+{
+    EXPECT_NONFATAL_FAILURE(AllocatesInsideScope(), "Expected no heap allocation");
+}
+
+int main(int argc, char **argv) {
+    testing::InitGoogleTest(&argc, argv);
+    InstallTestTiming();
+    InstallAllocationTracking();
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,281 @@
+#ifndef __BENCH_TEST_H__
+#define __BENCH_TEST_H__
+
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <initializer_list>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// 注册到 gtest 的微基准测试，和普通测试一样可以用 --gtest_filter 选择
+//
+//   BENCH_TEST(AddBench, Scalar) {
+//       int a = 1, b = 2;
+//       for (auto _ : state) {
+//           bench::DoNotOptimize(add(a, b));
+//       }
+//   }
+//
+//   BENCH_TEST_P(AddNBench, Avx2) {
+//       std::vector<int> a(state.range()), ...;
+//       for (auto _ : state) { ... }
+//   }
+//   BENCH_INSTANTIATE(Sizes, AddNBench, Avx2, bench::Range(64, 1 << 20, 8));
+//
+// 流程：预热 -> 自动调整每个样本的迭代次数 -> 采集若干样本 -> 报告 median / p99 / MAD（ns/iter）
+// 结果打印到标准输出，同时通过 RecordProperty 写入 --gtest_output 的 XML/JSON 报告
+// 环境变量 BENCH_SAMPLES（默认 20）和 BENCH_SAMPLE_MS（默认 2）可以调整采样规模
+namespace bench {
+
+template <typename T>
+inline void DoNotOptimize(const T &value)
+{
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+template <typename T>
+inline void DoNotOptimize(T &value)
+{
+    asm volatile("" : "+r,m"(value) : : "memory");
+}
+
+inline void ClobberMemory()
+{
+    asm volatile("" : : : "memory");
+}
+
+class State
+{
+public:
+    State(size_t iterations, int64_t range)
+    : _iterations(iterations)
+    , _range(range)
+    {}
+
+    // for (auto _ : state) 的循环变量；构造和析构函数不是平凡的，编译器不会报“变量未使用”
+    struct Value
+    {
+        Value() {}
+        ~Value() {}
+    };
+
+    struct Iterator
+    {
+        size_t remaining;
+        bool operator!=(const Iterator &) const { return remaining != 0; }
+        void operator++() { --remaining; }
+        Value operator*() const { return Value(); }
+    };
+
+    Iterator begin() { return Iterator {_iterations}; }
+    Iterator end() { return Iterator {0}; }
+
+    size_t iterations() const { return _iterations; }
+    // BENCH_TEST_P 的参数；普通 BENCH_TEST 中为 0
+    int64_t range() const { return _range; }
+
+private:
+    size_t _iterations;
+    int64_t _range;
+};
+
+using BenchFunc = void (*)(State &);
+
+struct Stats
+{
+    double median;
+    double p99;
+    double mad;
+    double min;
+    size_t samples;
+    size_t iterations;
+};
+
+// 样本为 ns/iter；p99 取最近秩
+inline Stats Summarize(std::vector<double> samples, size_t iterations)
+{
+    Stats s {};
+    s.samples = samples.size();
+    s.iterations = iterations;
+    if (samples.empty()) {
+        return s;
+    }
+    std::sort(samples.begin(), samples.end());
+    auto median = [](const std::vector<double> &v) {
+        size_t n = v.size();
+        return n % 2 ? v[n / 2] : (v[n / 2 - 1] + v[n / 2]) / 2;
+    };
+    s.median = median(samples);
+    s.min = samples.front();
+    size_t rank = static_cast<size_t>(std::ceil(0.99 * samples.size()));
+    s.p99 = samples[rank ? rank - 1 : 0];
+    std::vector<double> dev;
+    for (double x : samples) {
+        dev.push_back(std::fabs(x - s.median));
+    }
+    std::sort(dev.begin(), dev.end());
+    s.mad = median(dev);
+    return s;
+}
+
+inline size_t EnvOr(const char *name, size_t fallback)
+{
+    const char *v = std::getenv(name);
+    return v && *v ? static_cast<size_t>(std::strtoull(v, nullptr, 10)) : fallback;
+}
+
+inline double TimeOnce(BenchFunc func, size_t iterations, int64_t range)
+{
+    State state(iterations, range);
+    auto start = std::chrono::steady_clock::now();
+    func(state);
+    ClobberMemory();
+    return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+}
+
+inline Stats Run(BenchFunc func, int64_t range)
+{
+    const size_t samples = std::max<size_t>(EnvOr("BENCH_SAMPLES", 20), 1);
+    const double sampleNs = std::max<size_t>(EnvOr("BENCH_SAMPLE_MS", 2), 1) * 1e6;
+
+    // 预热 + 标定：迭代次数翻倍，直到一个样本的耗时达到目标
+    size_t iterations = 1;
+    double elapsed = TimeOnce(func, iterations, range);
+    while (elapsed < sampleNs && iterations < (size_t(1) << 40)) {
+        double scale = elapsed > 0 ? sampleNs / elapsed : 10;
+        iterations = static_cast<size_t>(iterations * std::min(std::max(scale * 1.2, 2.0), 10.0));
+        elapsed = TimeOnce(func, iterations, range);
+    }
+
+    std::vector<double> perIter;
+    for (size_t i = 0; i < samples; ++i) {
+        perIter.push_back(TimeOnce(func, iterations, range) / iterations);
+    }
+    return Summarize(perIter, iterations);
+}
+
+class BenchTest : public ::testing::Test
+{
+public:
+    BenchTest(BenchFunc func, int64_t range)
+    : _func(func)
+    , _range(range)
+    {}
+
+    void TestBody() override
+    {
+        Stats s = bench::Run(_func, _range);
+        const ::testing::TestInfo *info = ::testing::UnitTest::GetInstance()->current_test_info();
+        std::printf("[  BENCH   ] %s.%s: median %.2f ns/iter, p99 %.2f, MAD %.2f, min %.2f (%zu samples x %zu iters)\n",
+                    info->test_suite_name(), info->name(), s.median, s.p99, s.mad, s.min,
+                    s.samples, s.iterations);
+        std::fflush(stdout);
+        RecordProperty("median_ns", Format(s.median));
+        RecordProperty("p99_ns", Format(s.p99));
+        RecordProperty("mad_ns", Format(s.mad));
+        RecordProperty("iterations", static_cast<int>(std::min<size_t>(s.iterations, INT32_MAX)));
+    }
+
+private:
+    static std::string Format(double v)
+    {
+        char buf[32];
+        std::snprintf(buf, sizeof(buf), "%.3f", v);
+        return buf;
+    }
+
+    BenchFunc _func;
+    int64_t _range;
+};
+
+inline bool Register(const char *suite, const std::string &name, const char *file, int line,
+                     BenchFunc func, int64_t range = 0)
+{
+    ::testing::RegisterTest(suite, name.c_str(), nullptr, nullptr, file, line,
+                            [func, range]() -> ::testing::Test * { return new BenchTest(func, range); });
+    return true;
+}
+
+// 与 INSTANTIATE_TEST_SUITE_P 一样，每个参数值注册为 Prefix/Suite.Name/值
+inline bool RegisterRange(const std::string &prefix, const char *suite, const char *name,
+                          const char *file, int line, BenchFunc func, const std::vector<int64_t> &values)
+{
+    std::string fullSuite = prefix + "/" + suite;
+    for (int64_t v : values) {
+        Register(fullSuite.c_str(), std::string(name) + "/" + std::to_string(v), file, line, func, v);
+    }
+    return true;
+}
+
+// lo, lo*mult, lo*mult^2 ...，最后一个值固定为 hi
+// 和 Google Benchmark 一样，lo 为 0 时 0 单独作为一个值，等比数列从 1 开始
+// 这些函数在静态注册时调用，参数不合法直接抛 std::invalid_argument，而不是死循环
+inline std::vector<int64_t> Range(int64_t lo, int64_t hi, int64_t mult = 8)
+{
+    if (lo < 0 || hi < lo) {
+        throw std::invalid_argument("bench::Range: need 0 <= lo <= hi");
+    }
+    if (mult < 2) {
+        throw std::invalid_argument("bench::Range: mult must be >= 2");
+    }
+    std::vector<int64_t> v;
+    if (lo == 0) {
+        v.push_back(0);
+        if (hi == 0) {
+            return v;
+        }
+        lo = 1;
+    }
+    for (int64_t x = lo; x < hi; x *= mult) {
+        v.push_back(x);
+        if (x > hi / mult) {
+            break;
+        }
+    }
+    v.push_back(hi);
+    return v;
+}
+
+inline std::vector<int64_t> DenseRange(int64_t lo, int64_t hi, int64_t step = 1)
+{
+    if (step <= 0) {
+        throw std::invalid_argument("bench::DenseRange: step must be > 0");
+    }
+    std::vector<int64_t> v;
+    for (int64_t x = lo; x <= hi; x += step) {
+        v.push_back(x);
+        if (x > hi - step) {
+            break;
+        }
+    }
+    return v;
+}
+
+inline std::vector<int64_t> Values(std::initializer_list<int64_t> values)
+{
+    return std::vector<int64_t>(values);
+}
+
+}
+
+#define BENCH_TEST(suite, name)                                                          \
+    static void suite##_##name##_Bench(::bench::State &state);                           \
+    static const bool suite##_##name##_BenchRegistered =                                 \
+        ::bench::Register(#suite, #name, __FILE__, __LINE__, &suite##_##name##_Bench);   \
+    static void suite##_##name##_Bench(::bench::State &state)
+
+#define BENCH_TEST_P(suite, name)                                                        \
+    static void suite##_##name##_BenchP(::bench::State &state)
+
+#define BENCH_INSTANTIATE(prefix, suite, name, values)                                   \
+    static const bool prefix##_##suite##_##name##_BenchRegistered =                      \
+        ::bench::RegisterRange(#prefix, #suite, #name, __FILE__, __LINE__,               \
+                               &suite##_##name##_BenchP, values)
+
+#endif
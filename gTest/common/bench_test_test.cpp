@@ -0,0 +1,105 @@
+#include "bench_test.h"
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <numeric>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+TEST(BenchHarnessTest, SummarizeStatistics)
+{
+    std::vector<double> samples;
+    for (int i = 1; i <= 100; ++i) {
+        samples.push_back(i);
+    }
+    bench::Stats s = bench::Summarize(samples, 7);
+    EXPECT_DOUBLE_EQ(s.median, 50.5);
+    EXPECT_DOUBLE_EQ(s.p99, 99);
+    EXPECT_DOUBLE_EQ(s.mad, 25);
+    EXPECT_DOUBLE_EQ(s.min, 1);
+    EXPECT_EQ(s.samples, 100);
+    EXPECT_EQ(s.iterations, 7);
+
+    // 单个离群值不影响 median 和 MAD
+    bench::Stats outlier = bench::Summarize({10, 10, 11, 10, 1000}, 1);
+    EXPECT_DOUBLE_EQ(outlier.median, 10);
+    EXPECT_DOUBLE_EQ(outlier.mad, 0);
+    EXPECT_DOUBLE_EQ(outlier.p99, 1000);
+}
+
+TEST(BenchHarnessTest, Ranges)
+{
+    EXPECT_EQ(bench::Range(8, 512, 8), (std::vector<int64_t> {8, 64, 512}));
+    EXPECT_EQ(bench::Range(1, 100, 10), (std::vector<int64_t> {1, 10, 100}));
+    EXPECT_EQ(bench::Range(3, 3), (std::vector<int64_t> {3}));
+    EXPECT_EQ(bench::DenseRange(1, 7, 3), (std::vector<int64_t> {1, 4, 7}));
+    EXPECT_EQ(bench::Values({5, 2}), (std::vector<int64_t> {5, 2}));
+}
+
+TEST(BenchHarnessTest, RangeEdges)
+{
+    // 0 单独一个值，之后从 1 开始
+    EXPECT_EQ(bench::Range(0, 64), (std::vector<int64_t> {0, 1, 8, 64}));
+    EXPECT_EQ(bench::Range(0, 0), (std::vector<int64_t> {0}));
+    EXPECT_EQ(bench::Range(1, 1), (std::vector<int64_t> {1}));
+    EXPECT_EQ(bench::Range(1, INT64_MAX, 1 << 30).back(), INT64_MAX);
+    EXPECT_THROW(bench::Range(-1, 64), std::invalid_argument);
+    EXPECT_THROW(bench::Range(1, 64, 1), std::invalid_argument);
+    EXPECT_THROW(bench::Range(64, 1), std::invalid_argument);
+    EXPECT_THROW(bench::DenseRange(0, 10, 0), std::invalid_argument);
+    EXPECT_THROW(bench::DenseRange(0, 10, -1), std::invalid_argument);
+    EXPECT_EQ(bench::DenseRange(INT64_MAX - 1, INT64_MAX, 2), (std::vector<int64_t> {INT64_MAX - 1}));
+}
+
+TEST(BenchHarnessTest, StateRunsRequestedIterations)
+{
+    bench::State state(37, 5);
+    size_t count = 0;
+    for (auto _ : state) {
+        ++count;
+    }
+    EXPECT_EQ(count, 37);
+    EXPECT_EQ(state.range(), 5);
+}
+
+static bool HasTest(const std::string &suite, const std::string &name)
+{
+    const ::testing::UnitTest &unit = *::testing::UnitTest::GetInstance();
+    for (int i = 0; i < unit.total_test_suite_count(); ++i) {
+        const ::testing::TestSuite &ts = *unit.GetTestSuite(i);
+        if (suite != ts.name()) {
+            continue;
+        }
+        for (int j = 0; j < ts.total_test_count(); ++j) {
+            if (name == ts.GetTestInfo(j)->name()) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+BENCH_TEST(HarnessBench, Accumulate) {
+    std::vector<int> v(256, 1);
+    for (auto _ : state) {
+        int sum = std::accumulate(v.begin(), v.end(), 0);
+        bench::DoNotOptimize(sum);
+    }
+}
+
+BENCH_TEST_P(HarnessBench, Fill) {
+    std::vector<char> buf(static_cast<size_t>(state.range()));
+    for (auto _ : state) {
+        std::fill(buf.begin(), buf.end(), 1);
+        bench::ClobberMemory();
+    }
+}
+BENCH_INSTANTIATE(Sizes, HarnessBench, Fill, bench::Range(64, 4096, 8));
+
+TEST(BenchHarnessTest, BenchmarksAreRegisteredAsTests)
+{
+    EXPECT_TRUE(HasTest("HarnessBench", "Accumulate"));
+    EXPECT_TRUE(HasTest("Sizes/HarnessBench", "Fill/64"));
+    EXPECT_TRUE(HasTest("Sizes/HarnessBench", "Fill/512"));
+    EXPECT_TRUE(HasTest("Sizes/HarnessBench", "Fill/4096"));
+}
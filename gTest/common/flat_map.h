@@ -0,0 +1,168 @@
+#ifndef __FLAT_MAP_H__
+#define __FLAT_MAP_H__
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+// 基于有序连续数组的 map：键值对按 key 排好序放在一个 std::vector 里
+// 和 std::map 相比没有逐元素的节点分配，遍历是顺序访问，移动只是交换三个指针
+//   - 批量构造：接收无序输入，排序一次再去重（重复的 key 保留先出现的，和逐个 insert 进 std::map 一致）
+//   - 查找：无分支的二分（循环体编译成 cmov），适合随机查找
+//   - 单个 insert / erase 是 O(n)，适合“一次构造、多次查找”的场景
+// 元素类型是 std::pair<K, V>（key 不是 const），不要通过迭代器改 key
+template <class K, class V, class Compare = std::less<K>>
+class FlatMap
+{
+public:
+    using key_type = K;
+    using mapped_type = V;
+    using value_type = std::pair<K, V>;
+    using size_type = size_t;
+    using iterator = typename std::vector<value_type>::iterator;
+    using const_iterator = typename std::vector<value_type>::const_iterator;
+
+    FlatMap() = default;
+
+    explicit FlatMap(std::vector<value_type> items, const Compare &comp = Compare())
+    : _items(std::move(items))
+    , _comp(comp)
+    {
+        normalize();
+    }
+
+    template <class InputIt>
+    FlatMap(InputIt first, InputIt last, const Compare &comp = Compare())
+    : _items(first, last)
+    , _comp(comp)
+    {
+        normalize();
+    }
+
+    FlatMap(std::initializer_list<value_type> items, const Compare &comp = Compare())
+    : _items(items)
+    , _comp(comp)
+    {
+        normalize();
+    }
+
+    FlatMap(const FlatMap &) = default;
+    FlatMap &operator=(const FlatMap &) = default;
+    FlatMap(FlatMap &&) noexcept = default;
+    FlatMap &operator=(FlatMap &&) noexcept = default;
+
+    iterator begin() { return _items.begin(); }
+    iterator end() { return _items.end(); }
+    const_iterator begin() const { return _items.begin(); }
+    const_iterator end() const { return _items.end(); }
+
+    size_t size() const { return _items.size(); }
+    bool empty() const { return _items.empty(); }
+    void reserve(size_t n) { _items.reserve(n); }
+    void clear() { _items.clear(); }
+
+    const_iterator lower_bound(const K &key) const
+    {
+        return _items.begin() + lowerBoundIndex(key);
+    }
+
+    iterator lower_bound(const K &key)
+    {
+        return _items.begin() + lowerBoundIndex(key);
+    }
+
+    const_iterator find(const K &key) const
+    {
+        const_iterator it = lower_bound(key);
+        return it != end() && !_comp(key, it->first) ? it : end();
+    }
+
+    iterator find(const K &key)
+    {
+        iterator it = lower_bound(key);
+        return it != end() && !_comp(key, it->first) ? it : end();
+    }
+
+    size_t count(const K &key) const { return find(key) != end() ? 1 : 0; }
+    bool contains(const K &key) const { return find(key) != end(); }
+
+    const V &at(const K &key) const
+    {
+        const_iterator it = find(key);
+        if (it == end()) {
+            throw std::out_of_range("FlatMap::at");
+        }
+        return it->second;
+    }
+
+    V &at(const K &key)
+    {
+        return const_cast<V &>(static_cast<const FlatMap &>(*this).at(key));
+    }
+
+    V &operator[](const K &key)
+    {
+        return insert(value_type(key, V())).first->second;
+    }
+
+    std::pair<iterator, bool> insert(value_type item)
+    {
+        iterator it = lower_bound(item.first);
+        if (it != end() && !_comp(item.first, it->first)) {
+            return {it, false};
+        }
+        return {_items.insert(it, std::move(item)), true};
+    }
+
+    size_t erase(const K &key)
+    {
+        iterator it = find(key);
+        if (it == end()) {
+            return 0;
+        }
+        _items.erase(it);
+        return 1;
+    }
+
+    iterator erase(const_iterator pos) { return _items.erase(pos); }
+
+    friend bool operator==(const FlatMap &a, const FlatMap &b) { return a._items == b._items; }
+    friend bool operator!=(const FlatMap &a, const FlatMap &b) { return !(a == b); }
+
+private:
+    void normalize()
+    {
+        // stable_sort 保证重复 key 里先出现的排在前面，unique 保留它
+        std::stable_sort(_items.begin(), _items.end(), [this](const value_type &a, const value_type &b) {
+            return _comp(a.first, b.first);
+        });
+        auto last = std::unique(_items.begin(), _items.end(), [this](const value_type &a, const value_type &b) {
+            return !_comp(a.first, b.first);
+        });
+        _items.erase(last, _items.end());
+    }
+
+    size_t lowerBoundIndex(const K &key) const
+    {
+        size_t n = _items.size();
+        if (n == 0) {
+            return 0;
+        }
+        const value_type *base = _items.data();
+        while (n > 1) {
+            size_t half = n / 2;
+            base = _comp(base[half].first, key) ? base + half : base;
+            n -= half;
+        }
+        return static_cast<size_t>(base - _items.data()) + (_comp(base->first, key) ? 1 : 0);
+    }
+
+    std::vector<value_type> _items;
+    Compare _comp;
+};
+
+#endif
@@ -0,0 +1,89 @@
+#include "flat_map.h"
+#include <gtest/gtest.h>
+#include <map>
+#include <random>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+TEST(FlatMapTest, BulkConstructionSortsAndKeepsFirstDuplicate)
+{
+    FlatMap<int, int> m({{3, 30}, {1, 10}, {2, 20}, {1, 11}, {3, 31}});
+    ASSERT_EQ(m.size(), 3);
+    std::vector<std::pair<int, int>> items(m.begin(), m.end());
+    EXPECT_EQ(items, (std::vector<std::pair<int, int>> {{1, 10}, {2, 20}, {3, 30}}));
+}
+
+TEST(FlatMapTest, MatchesStdMap)
+{
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<int> key(-500, 500);
+    std::vector<std::pair<int, int>> input;
+    std::map<int, int> expected;
+    for (int i = 0; i < 2000; ++i) {
+        int k = key(rng);
+        input.emplace_back(k, i);
+        expected.insert({k, i});
+    }
+    FlatMap<int, int> m(input.begin(), input.end());
+    ASSERT_EQ(m.size(), expected.size());
+    EXPECT_TRUE(std::equal(m.begin(), m.end(), expected.begin(),
+                           [](const std::pair<int, int> &a, const std::pair<const int, int> &b) {
+                               return a.first == b.first && a.second == b.second;
+                           }));
+
+    for (int k = -600; k <= 600; ++k) {
+        auto it = m.find(k);
+        auto ref = expected.find(k);
+        ASSERT_EQ(it == m.end(), ref == expected.end()) << k;
+        if (ref != expected.end()) {
+            EXPECT_EQ(it->second, ref->second);
+        }
+        auto lb = m.lower_bound(k);
+        auto refLb = expected.lower_bound(k);
+        ASSERT_EQ(lb == m.end(), refLb == expected.end()) << k;
+        if (refLb != expected.end()) {
+            EXPECT_EQ(lb->first, refLb->first);
+        }
+    }
+}
+
+TEST(FlatMapTest, InsertEraseAndAccess)
+{
+    FlatMap<std::string, int> m;
+    EXPECT_TRUE(m.insert({"b", 2}).second);
+    EXPECT_TRUE(m.insert({"a", 1}).second);
+    EXPECT_FALSE(m.insert({"a", 9}).second);
+    m["c"] = 3;
+    ++m["a"];
+    EXPECT_EQ(m.at("a"), 2);
+    EXPECT_EQ(m.count("c"), 1);
+    EXPECT_THROW(m.at("z"), std::out_of_range);
+    EXPECT_EQ(m.erase("b"), 1);
+    EXPECT_EQ(m.erase("b"), 0);
+    EXPECT_EQ(m.size(), 2);
+    EXPECT_EQ(m.begin()->first, "a");
+}
+
+TEST(FlatMapTest, EmptyAndGreaterCompare)
+{
+    FlatMap<int, int> empty;
+    EXPECT_EQ(empty.find(1), empty.end());
+    EXPECT_EQ(empty.lower_bound(1), empty.end());
+
+    FlatMap<int, int, std::greater<int>> desc({{1, 1}, {3, 3}, {2, 2}});
+    EXPECT_EQ(desc.begin()->first, 3);
+    EXPECT_EQ(desc.find(2)->second, 2);
+    EXPECT_EQ(desc.lower_bound(0), desc.end());
+}
+
+TEST(FlatMapTest, MovesAreNoexceptAndCheap)
+{
+    static_assert(std::is_nothrow_move_constructible<FlatMap<int, int>>::value, "");
+    static_assert(std::is_nothrow_move_assignable<FlatMap<int, int>>::value, "");
+    FlatMap<int, int> a({{1, 1}, {2, 2}});
+    const std::pair<int, int> *data = &*a.begin();
+    FlatMap<int, int> b(std::move(a));
+    EXPECT_EQ(&*b.begin(), data);
+    EXPECT_EQ(b.size(), 2);
+}
@@ -0,0 +1,9 @@
+#include "test_timing.h"
+#include <gmock/gmock.h>
+
+// 可以替代 libgmock_main.a：和 timing_main.cpp 一样记录每个测试的耗时，另外解析 gmock 的命令行参数
+int main(int argc, char **argv) {
+    testing::InitGoogleMock(&argc, argv);
+    InstallTestTiming();
+    return RUN_ALL_TESTS();
+}
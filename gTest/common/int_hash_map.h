@@ -0,0 +1,402 @@
+#ifndef __INT_HASH_MAP_H__
+#define __INT_HASH_MAP_H__
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+// 整数 key 的开放寻址哈希表（Swiss table 的做法），用于只做点查、不关心顺序的 map<int, int>
+//
+// 每个槽位有一个控制字节：空槽是 0x80，有元素时存 key 哈希的高 7 位（0..127）
+// 查找时一次取 16 个控制字节（SSE2 一条比较指令），只对哈希高 7 位相同的槽位比较 key，
+// 这一组里有空槽就说明 key 不存在
+//
+// 探测是逐槽位的线性探测，按 16 个一组并行检查；控制字节数组末尾复制了开头的 15 个字节，
+// 所以从任意位置取一组都不用处理回绕
+// 删除用 backward shift：把后面不在自己起始位置的元素往前挪，没有墓碑，删得再多查找也不会变慢
+//
+// 最大负载 7/8，满了容量翻倍；事先知道元素个数时先 reserve，避免插入过程中反复 rehash
+// 槽位里是 std::pair<K, V>，V 需要能默认构造；插入、删除、rehash 都会让迭代器和引用失效
+template <class K = int, class V = int>
+class IntHashMap
+{
+    static_assert(std::is_integral<K>::value, "IntHashMap only supports integral keys");
+
+    static const size_t kGroup = 16;
+    static const int8_t kEmpty = static_cast<int8_t>(0x80);
+
+public:
+    using key_type = K;
+    using mapped_type = V;
+    using value_type = std::pair<K, V>;
+    using size_type = size_t;
+
+    template <bool Const>
+    class Iterator
+    {
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = std::pair<K, V>;
+        using difference_type = std::ptrdiff_t;
+        using reference = typename std::conditional<Const, const value_type &, value_type &>::type;
+        using pointer = typename std::conditional<Const, const value_type *, value_type *>::type;
+
+        Iterator() = default;
+
+        // iterator 可以转换成 const_iterator
+        template <bool C = Const, class = typename std::enable_if<C>::type>
+        Iterator(const Iterator<false> &other)
+        : _ctrl(other._ctrl)
+        , _slot(other._slot)
+        , _end(other._end)
+        {}
+
+        reference operator*() const { return *_slot; }
+        pointer operator->() const { return _slot; }
+
+        Iterator &operator++()
+        {
+            ++_ctrl;
+            ++_slot;
+            skipEmpty();
+            return *this;
+        }
+
+        Iterator operator++(int)
+        {
+            Iterator old = *this;
+            ++*this;
+            return old;
+        }
+
+        friend bool operator==(const Iterator &a, const Iterator &b) { return a._slot == b._slot; }
+        friend bool operator!=(const Iterator &a, const Iterator &b) { return a._slot != b._slot; }
+
+    private:
+        friend class IntHashMap;
+        friend class Iterator<!Const>;
+
+        Iterator(const int8_t *ctrl, pointer slot, const int8_t *end)
+        : _ctrl(ctrl)
+        , _slot(slot)
+        , _end(end)
+        {}
+
+        void skipEmpty()
+        {
+            while (_ctrl != _end && *_ctrl == kEmpty) {
+                ++_ctrl;
+                ++_slot;
+            }
+        }
+
+        const int8_t *_ctrl = nullptr;
+        pointer _slot = nullptr;
+        const int8_t *_end = nullptr;
+    };
+
+    using iterator = Iterator<false>;
+    using const_iterator = Iterator<true>;
+
+    IntHashMap() = default;
+
+    explicit IntHashMap(size_t n) { reserve(n); }
+
+    IntHashMap(std::initializer_list<value_type> items)
+    {
+        reserve(items.size());
+        for (const value_type &item : items) {
+            insert(item);
+        }
+    }
+
+    IntHashMap(const IntHashMap &) = default;
+    IntHashMap &operator=(const IntHashMap &) = default;
+
+    IntHashMap(IntHashMap &&other) noexcept
+    : _ctrl(std::move(other._ctrl))
+    , _slots(std::move(other._slots))
+    , _size(other._size)
+    {
+        other._size = 0;
+    }
+
+    IntHashMap &operator=(IntHashMap &&other) noexcept
+    {
+        _ctrl = std::move(other._ctrl);
+        _slots = std::move(other._slots);
+        _size = other._size;
+        other._size = 0;
+        return *this;
+    }
+
+    iterator begin()
+    {
+        iterator it = iteratorAt(0);
+        it.skipEmpty();
+        return it;
+    }
+
+    const_iterator begin() const
+    {
+        const_iterator it = iteratorAt(0);
+        it.skipEmpty();
+        return it;
+    }
+
+    iterator end() { return iteratorAt(capacity()); }
+    const_iterator end() const { return iteratorAt(capacity()); }
+
+    size_t size() const { return _size; }
+    bool empty() const { return _size == 0; }
+    size_t capacity() const { return _slots.size(); }
+
+    // 保证放得下 n 个元素而不再 rehash
+    void reserve(size_t n)
+    {
+        size_t cap = kGroup;
+        while (n > maxLoad(cap)) {
+            cap *= 2;
+        }
+        if (cap > capacity()) {
+            rehash(cap);
+        }
+    }
+
+    void clear()
+    {
+        std::fill(_ctrl.begin(), _ctrl.end(), kEmpty);
+        std::fill(_slots.begin(), _slots.end(), value_type());
+        _size = 0;
+    }
+
+    iterator find(K key)
+    {
+        size_t s = findSlot(key);
+        return s == kNotFound ? end() : iteratorAt(s);
+    }
+
+    const_iterator find(K key) const
+    {
+        size_t s = findSlot(key);
+        return s == kNotFound ? end() : iteratorAt(s);
+    }
+
+    size_t count(K key) const { return findSlot(key) != kNotFound ? 1 : 0; }
+    bool contains(K key) const { return findSlot(key) != kNotFound; }
+
+    const V &at(K key) const
+    {
+        size_t s = findSlot(key);
+        if (s == kNotFound) {
+            throw std::out_of_range("IntHashMap::at");
+        }
+        return _slots[s].second;
+    }
+
+    V &at(K key)
+    {
+        return const_cast<V &>(static_cast<const IntHashMap &>(*this).at(key));
+    }
+
+    V &operator[](K key)
+    {
+        return insert(value_type(key, V())).first->second;
+    }
+
+    // key 已存在时不覆盖，和 std::map::insert 一致
+    std::pair<iterator, bool> insert(value_type item)
+    {
+        size_t s = findSlot(item.first);
+        if (s != kNotFound) {
+            return {iteratorAt(s), false};
+        }
+        if (_size + 1 > maxLoad(capacity())) {
+            rehash(capacity() ? capacity() * 2 : kGroup);
+        }
+        s = insertSlot(item.first);
+        _slots[s] = std::move(item);
+        ++_size;
+        return {iteratorAt(s), true};
+    }
+
+    size_t erase(K key)
+    {
+        size_t s = findSlot(key);
+        if (s == kNotFound) {
+            return 0;
+        }
+        eraseSlot(s);
+        return 1;
+    }
+
+    friend bool operator==(const IntHashMap &a, const IntHashMap &b)
+    {
+        if (a.size() != b.size()) {
+            return false;
+        }
+        for (const value_type &item : a) {
+            auto it = b.find(item.first);
+            if (it == b.end() || !(it->second == item.second)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    friend bool operator!=(const IntHashMap &a, const IntHashMap &b) { return !(a == b); }
+
+private:
+    static const size_t kNotFound = static_cast<size_t>(-1);
+
+    static size_t maxLoad(size_t cap) { return cap - cap / 8; }
+
+    static uint64_t hash(K key)
+    {
+        uint64_t x = static_cast<uint64_t>(static_cast<typename std::make_unsigned<K>::type>(key));
+        x *= 0x9E3779B97F4A7C15ull;
+        return x ^ (x >> 32);
+    }
+
+    static int8_t h2(uint64_t h) { return static_cast<int8_t>(h >> 57); }
+
+    size_t mask() const { return capacity() - 1; }
+    size_t home(K key) const { return hash(key) & mask(); }
+
+    iterator iteratorAt(size_t s) { return iterator(_ctrl.data() + s, _slots.data() + s, _ctrl.data() + capacity()); }
+
+    const_iterator iteratorAt(size_t s) const
+    {
+        return const_iterator(_ctrl.data() + s, _slots.data() + s, _ctrl.data() + capacity());
+    }
+
+    // 一组 16 个控制字节里等于 tag 的位置（bit i 对应第 i 个字节）
+    static uint32_t matchGroup(const int8_t *g, int8_t tag)
+    {
+#ifdef __SSE2__
+        __m128i ctrl = _mm_loadu_si128(reinterpret_cast<const __m128i *>(g));
+        return static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(ctrl, _mm_set1_epi8(tag))));
+#else
+        uint32_t bits = 0;
+        for (size_t i = 0; i < kGroup; ++i) {
+            bits |= static_cast<uint32_t>(g[i] == tag) << i;
+        }
+        return bits;
+#endif
+    }
+
+    // 只有空槽的最高位是 1
+    static uint32_t emptyGroup(const int8_t *g)
+    {
+#ifdef __SSE2__
+        return static_cast<uint32_t>(_mm_movemask_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i *>(g))));
+#else
+        return matchGroup(g, kEmpty);
+#endif
+    }
+
+    size_t findSlot(K key) const
+    {
+        if (_size == 0) {
+            return kNotFound;
+        }
+        uint64_t h = hash(key);
+        int8_t tag = h2(h);
+        size_t m = mask();
+        size_t pos = h & m;
+        while (true) {
+            const int8_t *g = _ctrl.data() + pos;
+            for (uint32_t bits = matchGroup(g, tag); bits; bits &= bits - 1) {
+                size_t s = (pos + __builtin_ctz(bits)) & m;
+                if (_slots[s].first == key) {
+                    return s;
+                }
+            }
+            // 线性探测下 key 前面不会有空槽，组里出现空槽就可以停了
+            if (emptyGroup(g)) {
+                return kNotFound;
+            }
+            pos = (pos + kGroup) & m;
+        }
+    }
+
+    // 从 key 的起始位置往后第一个空槽，调用方保证 key 不在表里且还有空位
+    size_t insertSlot(K key)
+    {
+        uint64_t h = hash(key);
+        size_t m = mask();
+        size_t pos = h & m;
+        while (true) {
+            uint32_t bits = emptyGroup(_ctrl.data() + pos);
+            if (bits) {
+                size_t s = (pos + __builtin_ctz(bits)) & m;
+                setCtrl(s, h2(h));
+                return s;
+            }
+            pos = (pos + kGroup) & m;
+        }
+    }
+
+    void eraseSlot(size_t hole)
+    {
+        size_t m = mask();
+        setCtrl(hole, kEmpty);
+        --_size;
+        for (size_t j = (hole + 1) & m; _ctrl[j] != kEmpty; j = (j + 1) & m) {
+            // j 处的元素起始位置不在 (hole, j] 之间，挪到空位上不会破坏它的探测链
+            size_t dist = (j - home(_slots[j].first)) & m;
+            if (dist >= ((j - hole) & m)) {
+                _slots[hole] = std::move(_slots[j]);
+                setCtrl(hole, _ctrl[j]);
+                setCtrl(j, kEmpty);
+                hole = j;
+            }
+        }
+        _slots[hole] = value_type();
+    }
+
+    void setCtrl(size_t s, int8_t c)
+    {
+        _ctrl[s] = c;
+        // 开头的 kGroup - 1 个字节在末尾还有一份
+        if (s < kGroup - 1) {
+            _ctrl[capacity() + s] = c;
+        }
+    }
+
+    void rehash(size_t cap)
+    {
+        std::vector<int8_t> oldCtrl(cap + kGroup - 1, kEmpty);
+        std::vector<value_type> oldSlots(cap);
+        oldCtrl.swap(_ctrl);
+        oldSlots.swap(_slots);
+        for (size_t i = 0; i + kGroup - 1 < oldCtrl.size(); ++i) {
+            if (oldCtrl[i] != kEmpty) {
+                size_t s = insertSlot(oldSlots[i].first);
+                _slots[s] = std::move(oldSlots[i]);
+            }
+        }
+    }
+
+    std::vector<int8_t> _ctrl;       // capacity() + kGroup - 1 个控制字节
+    std::vector<value_type> _slots;  // 容量总是 2 的幂
+    size_t _size = 0;
+};
+
+template <class K, class V>
+const size_t IntHashMap<K, V>::kGroup;
+template <class K, class V>
+const int8_t IntHashMap<K, V>::kEmpty;
+template <class K, class V>
+const size_t IntHashMap<K, V>::kNotFound;
+
+#endif
@@ -0,0 +1,150 @@
+#include "int_hash_map.h"
+#include "flat_map.h"
+#include "map_matchers.h"
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include <climits>
+#include <map>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+using testing::Gt;
+using testing::Not;
+using testing::Pair;
+
+TEST(IntHashMapTest, InsertFindErase)
+{
+    IntHashMap<int, int> m;
+    EXPECT_TRUE(m.empty());
+    EXPECT_EQ(m.find(1), m.end());
+    EXPECT_TRUE(m.insert({1, 10}).second);
+    EXPECT_FALSE(m.insert({1, 11}).second);
+    EXPECT_EQ(m.at(1), 10);
+    m[2] = 20;
+    EXPECT_EQ(m.size(), 2);
+    EXPECT_EQ(m.erase(1), 1);
+    EXPECT_EQ(m.erase(1), 0);
+    EXPECT_FALSE(m.contains(1));
+    EXPECT_EQ(m.find(2)->second, 20);
+    EXPECT_THROW(m.at(1), std::out_of_range);
+}
+
+TEST(IntHashMapTest, NegativeAndExtremeKeys)
+{
+    IntHashMap<int, int> m({{INT_MIN, 1}, {-1, 2}, {0, 3}, {INT_MAX, 4}});
+    EXPECT_EQ(m.at(INT_MIN), 1);
+    EXPECT_EQ(m.at(-1), 2);
+    EXPECT_EQ(m.at(0), 3);
+    EXPECT_EQ(m.at(INT_MAX), 4);
+}
+
+TEST(IntHashMapTest, ReserveAvoidsRehash)
+{
+    IntHashMap<int, int> m;
+    m.reserve(1000);
+    size_t cap = m.capacity();
+    EXPECT_GE(cap, 1000);
+    for (int i = 0; i < 1000; ++i) {
+        m.insert({i, i});
+    }
+    EXPECT_EQ(m.capacity(), cap);
+}
+
+// 随机插入、删除，和 std::unordered_map 对照；key 范围小，保证探测链很长、backward shift 经常发生
+TEST(IntHashMapTest, MatchesUnorderedMapUnderChurn)
+{
+    std::mt19937 rng(7);
+    std::uniform_int_distribution<int> key(0, 300);
+    IntHashMap<int, int> m;
+    std::unordered_map<int, int> expected;
+    for (int i = 0; i < 200000; ++i) {
+        int k = key(rng);
+        if (rng() % 3 == 0) {
+            ASSERT_EQ(m.erase(k), expected.erase(k)) << i;
+        } else {
+            ASSERT_EQ(m.insert({k, i}).second, expected.insert({k, i}).second) << i;
+        }
+    }
+    ASSERT_EQ(m.size(), expected.size());
+    for (int k = -10; k < 320; ++k) {
+        auto it = m.find(k);
+        auto ref = expected.find(k);
+        ASSERT_EQ(it == m.end(), ref == expected.end()) << k;
+        if (ref != expected.end()) {
+            EXPECT_EQ(it->second, ref->second);
+        }
+    }
+
+    size_t visited = 0;
+    for (const auto &kv : m) {
+        EXPECT_EQ(expected.at(kv.first), kv.second);
+        ++visited;
+    }
+    EXPECT_EQ(visited, expected.size());
+}
+
+TEST(IntHashMapTest, EraseEverythingLeavesEmptyTable)
+{
+    IntHashMap<int, int> m;
+    for (int i = 0; i < 5000; ++i) {
+        m.insert({i * 16, i});  // 同一个余数类，挤在一起
+    }
+    for (int i = 0; i < 5000; ++i) {
+        ASSERT_EQ(m.erase(i * 16), 1) << i;
+        ASSERT_FALSE(m.contains(i * 16));
+        if (i + 1 < 5000) {
+            ASSERT_TRUE(m.contains((i + 1) * 16)) << i;
+        }
+    }
+    EXPECT_TRUE(m.empty());
+    EXPECT_EQ(m.begin(), m.end());
+}
+
+TEST(IntHashMapTest, CopyMoveAndEquality)
+{
+    IntHashMap<int, int> a({{1, 10}, {2, 20}});
+    IntHashMap<int, int> b = a;
+    EXPECT_EQ(a, b);
+    b[3] = 30;
+    EXPECT_NE(a, b);
+    IntHashMap<int, int> c = std::move(b);
+    EXPECT_EQ(c.size(), 3);
+    EXPECT_TRUE(b.empty());
+    EXPECT_EQ(b.begin(), b.end());
+}
+
+TEST(MapMatchersTest, ContainsKey)
+{
+    IntHashMap<int, int> h({{1, 10}, {2, 20}});
+    std::map<int, int> m({{1, 10}});
+    FlatMap<int, int> f({{5, 50}});
+    EXPECT_THAT(h, ContainsKey(2));
+    EXPECT_THAT(h, Not(ContainsKey(3)));
+    EXPECT_THAT(m, ContainsKey(1));
+    EXPECT_THAT(f, ContainsKey(5));
+    using Map = IntHashMap<int, int>;
+    EXPECT_EQ(testing::DescribeMatcher<Map>(ContainsKey(3)), "contains key 3");
+    EXPECT_EQ(testing::DescribeMatcher<Map>(ContainsKey(3), true), "doesn't contain key 3");
+}
+
+TEST(MapMatchersTest, ContainsEntry)
+{
+    IntHashMap<int, int> h({{1, 10}, {2, 20}});
+    EXPECT_THAT(h, ContainsEntry(1, 10));
+    EXPECT_THAT(h, ContainsEntry(2, Gt(15)));
+    EXPECT_THAT(h, Not(ContainsEntry(2, 10)));
+    EXPECT_THAT(h, Not(ContainsEntry(3, 10)));
+
+    testing::StringMatchResultListener listener;
+    EXPECT_FALSE(testing::ExplainMatchResult(ContainsEntry(2, 10), h, &listener));
+    EXPECT_EQ(listener.str(), "whose value is 20");
+}
+
+// IntHashMap 的迭代器符合标准容器的要求，gmock 自带的容器 matcher 也能用
+TEST(MapMatchersTest, WorksWithGmockContainerMatchers)
+{
+    IntHashMap<int, int> h({{1, 10}, {2, 20}});
+    EXPECT_THAT(h, testing::Contains(Pair(2, 20)));
+    EXPECT_THAT(h, testing::UnorderedElementsAre(Pair(1, 10), Pair(2, 20)));
+}
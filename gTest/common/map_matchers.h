@@ -0,0 +1,38 @@
+#ifndef __MAP_MATCHERS_H__
+#define __MAP_MATCHERS_H__
+
+#include <gmock/gmock.h>
+#include <string>
+
+// map 类容器的 gmock matcher，只依赖 count / find / size，
+// std::map、std::unordered_map、FlatMap、IntHashMap 都能用
+//
+//   EXPECT_THAT(m, ContainsKey(3));
+//   EXPECT_THAT(m, ContainsEntry(3, testing::Gt(10)));
+//
+// 和 testing::Contains(testing::Key(3)) 的区别是这里走容器自己的查找，不会遍历整个容器
+MATCHER_P(ContainsKey, key, std::string(negation ? "doesn't contain" : "contains") + " key " +
+                                ::testing::PrintToString(key))
+{
+    if (arg.count(key) != 0) {
+        return true;
+    }
+    *result_listener << "which has " << arg.size() << " entries";
+    return false;
+}
+
+// value 可以是值，也可以是 matcher；value 不匹配时的说明由 value 的 matcher 给出
+MATCHER_P2(ContainsEntry, key, value,
+           std::string(negation ? "doesn't contain" : "contains") + " key " + ::testing::PrintToString(key) +
+               " with a matching value")
+{
+    auto it = arg.find(key);
+    if (it == arg.end()) {
+        *result_listener << "which doesn't contain the key";
+        return false;
+    }
+    *result_listener << "whose value is " << ::testing::PrintToString(it->second);
+    return ::testing::ExplainMatchResult(value, it->second, result_listener);
+}
+
+#endif
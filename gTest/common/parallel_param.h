@@ -0,0 +1,407 @@
+#ifndef __PARALLEL_PARAM_H__
+#define __PARALLEL_PARAM_H__
+
+#include <gtest/gtest.h>
+#include <gtest/gtest-spi.h>
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// 参数化测试的多线程版本：一个参数化套件的所有参数实例在一个 gtest 测试里并行执行
+// 适合参数量很大、被测对象是纯函数的套件
+//
+//   class NumberTest : public ::testing::TestWithParam<std::tuple<int, int, int>> {};
+//
+//   PARALLEL_TEST_P(NumberTest, Commutative) {
+//       auto p = GetParam();
+//       EXPECT_EQ(add(std::get<0>(p), std::get<1>(p)), add(std::get<1>(p), std::get<0>(p)));
+//   }
+//   INSTANTIATE_PARALLEL_TEST_SUITE_P(Wide, NumberTest, ::testing::Combine(...));
+//
+// 注册成 Wide/NumberTest.Commutative 这一个测试，--gtest_filter 照常可用
+// 每个参数实例都会新建一个 fixture，依次执行 SetUp / TestBody / TearDown
+// ::testing::Test 的构造、析构会保存和恢复 gtest 的全局 flag，不能并发，所以 fixture 在调用线程上分批
+// 构造、析构，只有 SetUp / TestBody / TearDown 在工作线程上执行；fixture 构造函数里的失败不带参数下标
+// 各线程的失败先各自收集（gtest-spi 的线程内拦截），全部跑完后按参数顺序重放，输出与线程数无关
+//
+// 线程数：环境变量 GTEST_PARALLEL_THREADS，默认是 CPU 核数，设为 1 即串行
+// fixture 之间共享状态（静态成员、SetUpTestSuite 里的资源）的套件用 PARALLEL_TEST_SERIAL(Suite) 退出并行
+namespace parallel {
+
+template <class Suite>
+struct Traits
+{
+    static constexpr bool serial = false;
+};
+
+inline int ThreadCount()
+{
+    const char *env = std::getenv("GTEST_PARALLEL_THREADS");
+    int n = env ? std::atoi(env) : static_cast<int>(std::thread::hardware_concurrency());
+    return std::max(1, n);
+}
+
+// 工作窃取：每个线程持有一段连续的下标 [next, end)，从前面取；
+// 自己的取完后，从剩余最多的线程那里偷走后一半
+class WorkStealingPool
+{
+public:
+    // f(index, worker)，调用线程作为 0 号线程参与执行
+    template <class F>
+    static void Run(size_t n, int threads, F &&f)
+    {
+        threads = static_cast<int>(std::max<size_t>(1, std::min<size_t>(threads, n)));
+        std::unique_ptr<Range[]> ranges(new Range[threads]);
+        for (int w = 0; w < threads; ++w) {
+            ranges[w].next = n * w / threads;
+            ranges[w].end = n * (w + 1) / threads;
+        }
+        auto work = [&](int w) {
+            Range &own = ranges[w];
+            while (true) {
+                size_t i;
+                bool got = false;
+                {
+                    std::lock_guard<std::mutex> lock(own.lock);
+                    if (own.next < own.end) {
+                        i = own.next++;
+                        got = true;
+                    }
+                }
+                if (got) {
+                    f(i, w);
+                } else if (!Steal(ranges.get(), threads, w)) {
+                    return;
+                }
+            }
+        };
+        std::vector<std::thread> workers;
+        for (int w = 1; w < threads; ++w) {
+            workers.emplace_back(work, w);
+        }
+        work(0);
+        for (std::thread &t : workers) {
+            t.join();
+        }
+    }
+
+private:
+    // new[] 在 C++14 下不保证超过 16 字节的对齐，alignas(64) 并不生效；
+    // 改为在字段后面补一整条缓存行，相邻两个 Range 的字段不会落在同一行上
+    struct Range
+    {
+        std::mutex lock;
+        size_t next = 0;
+        size_t end = 0;
+        char pad[64];
+    };
+
+    static bool Steal(Range *ranges, int threads, int self)
+    {
+        while (true) {
+            int victim = -1;
+            size_t most = 0;
+            for (int w = 0; w < threads; ++w) {
+                std::lock_guard<std::mutex> lock(ranges[w].lock);
+                size_t left = ranges[w].end - ranges[w].next;
+                if (w != self && left > most) {
+                    most = left;
+                    victim = w;
+                }
+            }
+            if (victim < 0) {
+                return false;
+            }
+            size_t begin, end;
+            {
+                std::lock_guard<std::mutex> lock(ranges[victim].lock);
+                size_t left = ranges[victim].end - ranges[victim].next;
+                if (left == 0) {
+                    continue;   // 被别人抢先偷走了，重新挑
+                }
+                end = ranges[victim].end;
+                begin = end - (left + 1) / 2;
+                ranges[victim].end = begin;
+            }
+            std::lock_guard<std::mutex> lock(ranges[self].lock);
+            ranges[self].next = begin;
+            ranges[self].end = end;
+            return true;
+        }
+    }
+};
+
+// 当前线程正在执行的参数实例
+template <class T>
+const T *&CurrentParam()
+{
+    static thread_local const T *param = nullptr;
+    return param;
+}
+
+// ::testing::TestWithParam 的 GetParam() 读的是一个全局静态变量，只能在测试体里被下面的 Instance 遮蔽；
+// fixture 自己的 SetUp / TearDown 里也要用参数时，改为继承这个类
+template <class T>
+class TestWithParam : public ::testing::Test
+{
+public:
+    using ParamType = T;
+
+    static const T &GetParam() { return *CurrentParam<T>(); }
+};
+
+// 每个参数实例的 fixture；GetParam() 遮蔽掉 ::testing::TestWithParam 里依赖静态变量的版本
+template <class Suite>
+class Instance : public Suite
+{
+public:
+    using ParamType = typename Suite::ParamType;
+
+    explicit Instance(const ParamType &param)
+    : _param(param)
+    {}
+
+    const ParamType &GetParam() const { return _param; }
+
+    void TestBody() override = 0;
+
+    // 和 gtest 一样：SetUp 有致命失败就不执行 TestBody，TearDown 总会执行
+    void RunInstance(const ::testing::TestPartResultArray &results)
+    {
+        CurrentParam<ParamType>() = &_param;
+        Guard([this] { this->SetUp(); });
+        if (!HasFatal(results)) {
+            Guard([this] { this->TestBody(); });
+        }
+        Guard([this] { this->TearDown(); });
+        CurrentParam<ParamType>() = nullptr;
+    }
+
+private:
+    template <class F>
+    static void Guard(F &&f)
+    {
+        try {
+            f();
+        } catch (const std::exception &e) {
+            ADD_FAILURE() << "C++ exception with description \"" << e.what() << "\" thrown in the test body.";
+        } catch (...) {
+            ADD_FAILURE() << "Unknown C++ exception thrown in the test body.";
+        }
+    }
+
+    static bool HasFatal(const ::testing::TestPartResultArray &results)
+    {
+        for (int i = 0; i < results.size(); ++i) {
+            if (results.GetTestPartResult(i).fatally_failed()) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    const ParamType &_param;
+};
+
+struct Failure
+{
+    size_t index;
+    ::testing::TestPartResult result;
+};
+
+// 在 threads 个线程上跑完所有参数实例，返回按参数下标排好序的失败（含 skip）
+template <class Suite, class Create>
+std::vector<Failure> RunInstances(const std::vector<typename Suite::ParamType> &params, Create create, int threads)
+{
+    // 一批同时存活的 fixture 个数，参数很多时不至于一次全部构造出来
+    const size_t kBatch = 1024;
+    std::vector<std::vector<Failure>> perThread(std::max(1, threads));
+    std::vector<std::unique_ptr<Instance<Suite>>> tests;
+    for (size_t begin = 0; begin < params.size(); begin += kBatch) {
+        size_t n = std::min(kBatch, params.size() - begin);
+        for (size_t j = 0; j < n; ++j) {
+            tests.emplace_back(create(params[begin + j]));
+        }
+        WorkStealingPool::Run(n, threads, [&](size_t j, int w) {
+            ::testing::TestPartResultArray results;
+            {
+                ::testing::ScopedFakeTestPartResultReporter reporter(
+                    ::testing::ScopedFakeTestPartResultReporter::INTERCEPT_ONLY_CURRENT_THREAD, &results);
+                tests[j]->RunInstance(results);
+            }
+            for (int k = 0; k < results.size(); ++k) {
+                if (results.GetTestPartResult(k).type() != ::testing::TestPartResult::kSuccess) {
+                    perThread[w].push_back(Failure {begin + j, results.GetTestPartResult(k)});
+                }
+            }
+        });
+        tests.clear();
+    }
+    std::vector<Failure> all;
+    for (std::vector<Failure> &v : perThread) {
+        all.insert(all.end(), v.begin(), v.end());
+    }
+    // 每个下标只在一个线程上跑过，稳定排序保留同一实例内的失败顺序
+    std::stable_sort(all.begin(), all.end(), [](const Failure &a, const Failure &b) {
+        return a.index < b.index;
+    });
+    return all;
+}
+
+template <class Suite>
+class Registry
+{
+public:
+    using ParamType = typename Suite::ParamType;
+    using Create = Instance<Suite> *(*)(const ParamType &);
+
+    static bool AddPattern(const char *suite, const char *name, const char *file, int line, Create create)
+    {
+        patterns().push_back(Pattern {suite, name, file, line, create});
+        for (const Instantiation &inst : instantiations()) {
+            Register(patterns().back(), inst);
+        }
+        return true;
+    }
+
+    static bool AddInstantiation(const char *prefix, ::testing::internal::ParamGenerator<ParamType> gen,
+                                 const char *file, int line)
+    {
+        instantiations().push_back(Instantiation {prefix, gen, file, line});
+        for (const Pattern &p : patterns()) {
+            Register(p, instantiations().back());
+        }
+        return true;
+    }
+
+private:
+    struct Pattern
+    {
+        const char *suite;
+        const char *name;
+        const char *file;
+        int line;
+        Create create;
+    };
+
+    struct Instantiation
+    {
+        const char *prefix;
+        ::testing::internal::ParamGenerator<ParamType> gen;
+        const char *file;
+        int line;
+    };
+
+    // 注册给 gtest 的测试本身，负责展开参数、调度和重放失败
+    class Runner : public Suite
+    {
+    public:
+        Runner(Pattern pattern, ::testing::internal::ParamGenerator<ParamType> gen)
+        : _pattern(pattern)
+        , _gen(gen)
+        {}
+
+        void SetUp() override {}
+        void TearDown() override {}
+
+        void TestBody() override
+        {
+            std::vector<ParamType> params;
+            for (const ParamType &p : _gen) {
+                params.push_back(p);
+            }
+            int threads = Traits<Suite>::serial ? 1 : ThreadCount();
+            threads = static_cast<int>(std::max<size_t>(1, std::min<size_t>(threads, params.size())));
+            std::vector<Failure> failures = RunInstances<Suite>(params, _pattern.create, threads);
+
+            const size_t kMaxReported = 100;
+            size_t failed = 0, skipped = 0;
+            for (size_t k = 0; k < failures.size(); ++k) {
+                const Failure &f = failures[k];
+                bool first = k == 0 || failures[k - 1].index != f.index;
+                if (f.result.skipped()) {
+                    skipped += first;
+                    continue;
+                }
+                failed += first;
+                if (failed > kMaxReported) {
+                    continue;
+                }
+                const char *file = f.result.file_name() ? f.result.file_name() : "unknown file";
+                ADD_FAILURE_AT(file, f.result.line_number())
+                    << "parameter #" << f.index << ": " << ::testing::PrintToString(params[f.index]) << "\n"
+                    << f.result.message();
+            }
+            if (failed > kMaxReported) {
+                ADD_FAILURE() << (failed - kMaxReported) << " more failing parameters not shown";
+            }
+            std::printf("[ PARALLEL ] %zu instances on %d thread(s), %zu failed, %zu skipped\n",
+                        params.size(), threads, failed, skipped);
+            std::fflush(stdout);
+            this->RecordProperty("instances", static_cast<int>(params.size()));
+            this->RecordProperty("threads", threads);
+        }
+
+    private:
+        Pattern _pattern;
+        ::testing::internal::ParamGenerator<ParamType> _gen;
+    };
+
+    static void Register(const Pattern &p, const Instantiation &inst)
+    {
+        std::string suite = std::string(inst.prefix) + "/" + p.suite;
+        Pattern pattern = p;
+        ::testing::internal::ParamGenerator<ParamType> gen = inst.gen;
+        ::testing::RegisterTest(suite.c_str(), p.name, nullptr, nullptr, p.file, p.line,
+                                [pattern, gen]() -> Suite * { return new Runner(pattern, gen); });
+    }
+
+    static std::vector<Pattern> &patterns()
+    {
+        static std::vector<Pattern> v;
+        return v;
+    }
+
+    static std::vector<Instantiation> &instantiations()
+    {
+        static std::vector<Instantiation> v;
+        return v;
+    }
+};
+
+} // namespace parallel
+
+#define PARALLEL_TEST_SERIAL(suite)                   \
+    namespace parallel {                              \
+    template <>                                       \
+    struct Traits<suite>                              \
+    {                                                 \
+        static constexpr bool serial = true;          \
+    };                                                \
+    }
+
+#define PARALLEL_TEST_P(suite, name)                                                              \
+    class suite##_##name##_ParallelTest : public ::parallel::Instance<suite>                      \
+    {                                                                                             \
+    public:                                                                                       \
+        using ::parallel::Instance<suite>::Instance;                                              \
+        void TestBody() override;                                                                 \
+    };                                                                                            \
+    static bool suite##_##name##_parallel_registered = ::parallel::Registry<suite>::AddPattern(   \
+        #suite, #name, __FILE__, __LINE__,                                                        \
+        [](const suite::ParamType &p) -> ::parallel::Instance<suite> * {                          \
+            return new suite##_##name##_ParallelTest(p);                                          \
+        });                                                                                       \
+    void suite##_##name##_ParallelTest::TestBody()
+
+#define INSTANTIATE_PARALLEL_TEST_SUITE_P(prefix, suite, ...)                                     \
+    static bool prefix##_##suite##_parallel_instantiated =                                        \
+        ::parallel::Registry<suite>::AddInstantiation(                                            \
+            #prefix, ::testing::internal::ParamGenerator<suite::ParamType>(__VA_ARGS__), __FILE__, __LINE__)
+
+#endif
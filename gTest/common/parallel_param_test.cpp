@@ -0,0 +1,143 @@
+#include "parallel_param.h"
+#include <gtest/gtest.h>
+#include <atomic>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+TEST(WorkStealingPoolTest, EveryIndexRunsExactlyOnce)
+{
+    const size_t n = 10000;
+    std::vector<std::atomic<int>> hits(n);
+    std::atomic<int> stolen {0};
+    parallel::WorkStealingPool::Run(n, 4, [&](size_t i, int w) {
+        hits[i].fetch_add(1);
+        // 0 号线程分到的前 1/4 特别慢，逼其他线程来偷
+        if (i < n / 4) {
+            std::this_thread::sleep_for(std::chrono::microseconds(20));
+            stolen += w != 0;
+        }
+    });
+    for (size_t i = 0; i < n; ++i) {
+        ASSERT_EQ(hits[i].load(), 1) << i;
+    }
+    EXPECT_GT(stolen.load(), 0);
+}
+
+TEST(WorkStealingPoolTest, FewerItemsThanThreads)
+{
+    std::atomic<int> count {0};
+    parallel::WorkStealingPool::Run(3, 8, [&](size_t, int) { ++count; });
+    EXPECT_EQ(count.load(), 3);
+    parallel::WorkStealingPool::Run(0, 8, [&](size_t, int) { ++count; });
+    EXPECT_EQ(count.load(), 3);
+}
+
+class OddFails : public parallel::TestWithParam<int>
+{
+protected:
+    void SetUp() override
+    {
+        ASSERT_NE(GetParam(), 13) << "setup";
+    }
+};
+
+class OddFailsCheck : public parallel::Instance<OddFails>
+{
+public:
+    using parallel::Instance<OddFails>::Instance;
+
+    void TestBody() override
+    {
+        if (GetParam() == 7) {
+            GTEST_SKIP();
+        }
+        EXPECT_EQ(GetParam() % 2, 0) << "first";
+        EXPECT_LT(GetParam(), 10) << "second";
+    }
+};
+
+static std::vector<std::string> Describe(const std::vector<parallel::Failure> &failures)
+{
+    std::vector<std::string> out;
+    for (const parallel::Failure &f : failures) {
+        std::string msg = f.result.message();
+        std::string tag = f.result.skipped() ? "skip" : msg.substr(msg.rfind('\n') + 1);
+        out.push_back(std::to_string(f.index) + ":" + tag);
+    }
+    return out;
+}
+
+TEST(ParallelParamTest, FailuresReplayInParameterOrder)
+{
+    std::vector<int> params;
+    for (int i = 0; i < 16; ++i) {
+        params.push_back(i);
+    }
+    auto create = [](const int &p) -> parallel::Instance<OddFails> * { return new OddFailsCheck(p); };
+    std::vector<std::string> serial = Describe(parallel::RunInstances<OddFails>(params, create, 1));
+    std::vector<std::string> expected = {
+        "1:first", "3:first", "5:first", "7:skip", "9:first",
+        "10:second", "11:first", "11:second", "12:second", "13:setup",
+        "14:second", "15:first", "15:second",
+    };
+    EXPECT_EQ(serial, expected);
+    for (int round = 0; round < 20; ++round) {
+        EXPECT_EQ(Describe(parallel::RunInstances<OddFails>(params, create, 4)), expected);
+    }
+}
+
+int add(int a, int b)
+{
+    return a + b;
+}
+
+class AddParallelTest : public ::testing::TestWithParam<std::tuple<int, int>> {};
+
+PARALLEL_TEST_P(AddParallelTest, Commutative) {
+    auto p = GetParam();
+    EXPECT_EQ(add(std::get<0>(p), std::get<1>(p)), add(std::get<1>(p), std::get<0>(p)));
+}
+
+INSTANTIATE_PARALLEL_TEST_SUITE_P(Grid, AddParallelTest,
+                                  ::testing::Combine(::testing::Range(-100, 100), ::testing::Range(-100, 100)));
+
+// 共享静态状态的 fixture，退出并行，实例按顺序在一个线程上执行
+class SharedCounterTest : public ::testing::TestWithParam<int>
+{
+protected:
+    static void SetUpTestSuite() { _next = 0; }
+
+    static int _next;
+};
+
+int SharedCounterTest::_next = 0;
+
+PARALLEL_TEST_SERIAL(SharedCounterTest)
+
+PARALLEL_TEST_P(SharedCounterTest, RunsInOrder) {
+    EXPECT_EQ(GetParam(), _next++);
+}
+
+INSTANTIATE_PARALLEL_TEST_SUITE_P(Serial, SharedCounterTest, ::testing::Range(0, 1000));
+
+static bool HasTest(const char *suite, const char *name)
+{
+    const ::testing::UnitTest &unit = *::testing::UnitTest::GetInstance();
+    for (int i = 0; i < unit.total_test_suite_count(); ++i) {
+        const ::testing::TestSuite &ts = *unit.GetTestSuite(i);
+        for (int j = 0; j < ts.total_test_count(); ++j) {
+            if (std::string(suite) == ts.name() && std::string(name) == ts.GetTestInfo(j)->name()) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+TEST(ParallelParamTest, RegisteredOncePerPatternAndInstantiation)
+{
+    EXPECT_TRUE(HasTest("Grid/AddParallelTest", "Commutative"));
+    EXPECT_TRUE(HasTest("Serial/SharedCounterTest", "RunsInOrder"));
+}
@@ -0,0 +1,287 @@
+#include "shard_runner.h"
+#include <chrono>
+#include <cstring>
+#include <dirent.h>
+#include <fcntl.h>
+#include <iostream>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <thread>
+#include <unistd.h>
+
+// 并行运行所有示例的测试可执行文件：
+//   shard_runner [-j N] [--history FILE] [--xml FILE] [--json FILE] [--target-ms MS] <构建目录>...
+// 构建目录里有 CTestTestfile.cmake 就直接读取，否则在它的下一级子目录里找（可以传一个放了很多构建目录的根目录）
+// 每个可执行文件用 GTEST_SHARD_INDEX / GTEST_TOTAL_SHARDS 切成若干分片，按历史耗时最长优先调度到 N 个进程上
+// 全部完成后合并各分片的 XML，输出一份总报告；有失败或错误时返回 1
+
+using namespace shard;
+
+static std::string ReadFile(const std::string &path)
+{
+    std::ifstream in(path);
+    std::stringstream ss;
+    ss << in.rdbuf();
+    return ss.str();
+}
+
+static bool IsFile(const std::string &path)
+{
+    struct stat st;
+    return stat(path.c_str(), &st) == 0 && S_ISREG(st.st_mode);
+}
+
+static void Discover(const std::string &dir, bool searchChildren, std::vector<TestBinary> &out)
+{
+    std::string file = dir + "/CTestTestfile.cmake";
+    if (IsFile(file)) {
+        std::vector<std::string> subdirs;
+        for (TestBinary &t : ParseCTestFile(ReadFile(file), dir, &subdirs)) {
+            out.push_back(std::move(t));
+        }
+        for (const std::string &s : subdirs) {
+            Discover(s, false, out);
+        }
+        return;
+    }
+    if (!searchChildren) {
+        return;
+    }
+    DIR *d = opendir(dir.c_str());
+    if (!d) {
+        return;
+    }
+    std::vector<std::string> children;
+    while (dirent *e = readdir(d)) {
+        if (e->d_name[0] != '.') {
+            children.push_back(dir + "/" + e->d_name);
+        }
+    }
+    closedir(d);
+    std::sort(children.begin(), children.end());
+    for (const std::string &c : children) {
+        Discover(c, false, out);
+    }
+}
+
+// fork + exec，stdout/stderr 写到 logPath；env 是额外的环境变量
+static pid_t Spawn(const TestBinary &t, const std::vector<std::string> &extraArgs,
+                   const std::vector<std::pair<std::string, std::string>> &env, const std::string &logPath)
+{
+    pid_t pid = fork();
+    if (pid != 0) {
+        return pid;
+    }
+    int fd = open(logPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd >= 0) {
+        dup2(fd, STDOUT_FILENO);
+        dup2(fd, STDERR_FILENO);
+        close(fd);
+    }
+    if (chdir(t.workdir.c_str()) != 0) {
+        _exit(127);
+    }
+    for (const auto &kv : env) {
+        setenv(kv.first.c_str(), kv.second.c_str(), 1);
+    }
+    std::vector<char *> argv;
+    for (const std::string &a : t.argv) {
+        argv.push_back(const_cast<char *>(a.c_str()));
+    }
+    for (const std::string &a : extraArgs) {
+        argv.push_back(const_cast<char *>(a.c_str()));
+    }
+    argv.push_back(nullptr);
+    execv(argv[0], argv.data());
+    _exit(127);
+}
+
+// --gtest_list_tests 统计用例数，用来限制分片数
+static int CountTests(const TestBinary &t, const std::string &tmpdir)
+{
+    std::string log = tmpdir + "/list.txt";
+    pid_t pid = Spawn(t, {"--gtest_list_tests"}, {}, log);
+    int status = 0;
+    waitpid(pid, &status, 0);
+    std::istringstream in(ReadFile(log));
+    std::string line;
+    int count = 0;
+    while (std::getline(in, line)) {
+        count += line.compare(0, 2, "  ") == 0;
+    }
+    return count;
+}
+
+static std::string DescribeStatus(int status)
+{
+    if (WIFSIGNALED(status)) {
+        return std::string("killed by signal ") + std::to_string(WTERMSIG(status)) + " (" +
+               strsignal(WTERMSIG(status)) + ")";
+    }
+    return "exit code " + std::to_string(WEXITSTATUS(status));
+}
+
+static void Usage()
+{
+    std::cerr << "usage: shard_runner [-j N] [--history FILE] [--xml FILE] [--json FILE] [--target-ms MS] "
+                 "<build dir>...\n";
+}
+
+int main(int argc, char **argv)
+{
+    int jobs = std::max(1u, std::thread::hardware_concurrency());
+    std::string historyPath = "shard_history.tsv";
+    std::string xmlPath = "shard_report.xml";
+    std::string jsonPath;
+    double targetMs = 200;
+    std::vector<std::string> dirs;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "-j" && hasValue) {
+            jobs = std::max(1, std::atoi(argv[++i]));
+        } else if (arg == "--history" && hasValue) {
+            historyPath = argv[++i];
+        } else if (arg == "--xml" && hasValue) {
+            xmlPath = argv[++i];
+        } else if (arg == "--json" && hasValue) {
+            jsonPath = argv[++i];
+        } else if (arg == "--target-ms" && hasValue) {
+            targetMs = std::max(1.0, std::atof(argv[++i]));
+        } else if (arg[0] == '-') {
+            Usage();
+            return 2;
+        } else {
+            dirs.push_back(arg);
+        }
+    }
+    if (dirs.empty()) {
+        Usage();
+        return 2;
+    }
+
+    std::vector<TestBinary> binaries;
+    for (const std::string &d : dirs) {
+        Discover(d, true, binaries);
+    }
+    if (binaries.empty()) {
+        std::cerr << "no tests found\n";
+        return 2;
+    }
+
+    char tmpl[] = "/tmp/shard_runner_XXXXXX";
+    std::string tmpdir = mkdtemp(tmpl);
+    std::vector<int> counts;
+    for (const TestBinary &t : binaries) {
+        counts.push_back(CountTests(t, tmpdir));
+    }
+    History history;
+    history.load(historyPath);
+    std::vector<Shard> plan = Plan(binaries, counts, history, jobs, targetMs);
+    std::cout << "[ SHARDS   ] " << binaries.size() << " binaries, " << plan.size() << " shards, " << jobs
+              << " jobs\n";
+
+    struct Running
+    {
+        size_t shard;
+        std::chrono::steady_clock::time_point start;
+    };
+    std::map<pid_t, Running> running;
+    std::vector<int> statuses(plan.size(), 0);
+    std::vector<double> elapsedMs(plan.size(), 0);
+    auto path = [&](size_t i, const char *ext) {
+        return tmpdir + "/" + std::to_string(plan[i].binary) + "_" + std::to_string(plan[i].index) + ext;
+    };
+    auto begin = std::chrono::steady_clock::now();
+    size_t next = 0, done = 0;
+    while (done < plan.size()) {
+        while (next < plan.size() && running.size() < static_cast<size_t>(jobs)) {
+            const Shard &s = plan[next];
+            pid_t pid = Spawn(binaries[s.binary], {},
+                              {{"GTEST_SHARD_INDEX", std::to_string(s.index)},
+                               {"GTEST_TOTAL_SHARDS", std::to_string(s.total)},
+                               {"GTEST_OUTPUT", "xml:" + path(next, ".xml")}},
+                              path(next, ".log"));
+            running[pid] = Running {next, std::chrono::steady_clock::now()};
+            ++next;
+        }
+        int status = 0;
+        pid_t pid = wait(&status);
+        auto it = running.find(pid);
+        if (it == running.end()) {
+            continue;
+        }
+        size_t i = it->second.shard;
+        statuses[i] = status;
+        elapsedMs[i] = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() -
+                                                                 it->second.start).count();
+        running.erase(it);
+        ++done;
+        bool ok = WIFEXITED(status) && WEXITSTATUS(status) == 0;
+        std::printf("[%4zu/%zu] %-28s shard %d/%d %9.1f ms  %s\n", done, plan.size(),
+                    binaries[plan[i].binary].label().c_str(), plan[i].index + 1, plan[i].total, elapsedMs[i],
+                    ok ? "OK" : DescribeStatus(status).c_str());
+        std::fflush(stdout);
+    }
+    double wallMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+
+    // 按 可执行文件、分片 的顺序合并，报告内容与调度顺序无关
+    std::vector<size_t> order(plan.size());
+    for (size_t i = 0; i < order.size(); ++i) {
+        order[i] = i;
+    }
+    std::sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+        return std::make_pair(plan[a].binary, plan[a].index) < std::make_pair(plan[b].binary, plan[b].index);
+    });
+    Report report;
+    std::map<size_t, double> binaryMs;
+    for (size_t i : order) {
+        const TestBinary &t = binaries[plan[i].binary];
+        std::string shardName = "shard_" + std::to_string(plan[i].index + 1) + "_of_" + std::to_string(plan[i].total);
+        int status = statuses[i];
+        bool ok = WIFEXITED(status) && WEXITSTATUS(status) == 0;
+        Report::Totals before = report.totals();
+        bool parsed = report.addXml(t.label(), ReadFile(path(i, ".xml")));
+        bool newFailures = report.totals().failures > before.failures;
+        if (!parsed) {
+            report.addError(t.label(), shardName, DescribeStatus(status) + ", no XML report");
+        } else if (!ok && !newFailures) {
+            report.addError(t.label(), shardName, DescribeStatus(status) + " without failed tests");
+        }
+        if (!ok) {
+            std::cout << "\n[  FAILED  ] " << t.label() << " " << shardName << " (" << t.argv[0] << ")\n"
+                      << ReadFile(path(i, ".log"));
+        }
+        binaryMs[plan[i].binary] += elapsedMs[i];
+    }
+    for (const auto &kv : binaryMs) {
+        history.set(binaries[kv.first].argv[0], kv.second);
+    }
+    history.save(historyPath);
+
+    if (!xmlPath.empty()) {
+        std::ofstream out(xmlPath);
+        report.writeXml(out);
+    }
+    if (!jsonPath.empty()) {
+        std::ofstream out(jsonPath);
+        report.writeJson(out);
+    }
+    for (size_t i = 0; i < plan.size(); ++i) {
+        unlink(path(i, ".xml").c_str());
+        unlink(path(i, ".log").c_str());
+    }
+    unlink((tmpdir + "/list.txt").c_str());
+    rmdir(tmpdir.c_str());
+
+    Report::Totals all = report.totals();
+    std::printf("\n[==========] %d tests from %zu binaries ran. (%.1f ms wall)\n", all.tests, binaries.size(), wallMs);
+    std::printf("[  PASSED  ] %d tests.\n", all.tests - all.failures - all.disabled - all.skipped);
+    if (all.skipped) {
+        std::printf("[  SKIPPED ] %d tests.\n", all.skipped);
+    }
+    if (all.failures || report.errors()) {
+        std::printf("[  FAILED  ] %d tests, %d shard errors.\n", all.failures, report.errors());
+    }
+    return all.failures || report.errors() ? 1 : 0;
+}
@@ -0,0 +1,492 @@
+#ifndef __SHARD_RUNNER_H__
+#define __SHARD_RUNNER_H__
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <map>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+// shard_runner 的纯逻辑部分（不涉及进程），单独放在头文件里便于测试：
+//   1. 从构建目录的 CTestTestfile.cmake 里找出所有测试命令
+//   2. 根据历史耗时给每个可执行文件决定分片数，并按“最长优先”排好执行顺序
+//   3. 把各个分片输出的 gtest XML 合并成一份 XML / JSON 报告
+namespace shard {
+
+struct TestBinary
+{
+    std::string name;               // ctest 里的测试名
+    std::vector<std::string> argv;  // argv[0] 是可执行文件的绝对路径
+    std::string workdir;
+
+    std::string label() const
+    {
+        size_t slash = argv[0].find_last_of('/');
+        return slash == std::string::npos ? argv[0] : argv[0].substr(slash + 1);
+    }
+};
+
+// 读取 CTestTestfile.cmake 里的一个参数：支持 "quoted"、[=[bracket]=] 和裸单词
+inline bool ReadCMakeArg(const std::string &text, size_t &pos, std::string &out)
+{
+    while (pos < text.size() && (text[pos] == ' ' || text[pos] == '\t' || text[pos] == '\n')) {
+        ++pos;
+    }
+    if (pos >= text.size() || text[pos] == ')') {
+        return false;
+    }
+    out.clear();
+    if (text[pos] == '"') {
+        for (++pos; pos < text.size() && text[pos] != '"'; ++pos) {
+            if (text[pos] == '\\' && pos + 1 < text.size()) {
+                ++pos;
+            }
+            out += text[pos];
+        }
+        ++pos;
+    } else if (text[pos] == '[') {
+        size_t eq = text.find('[', pos + 1);
+        std::string close = "]" + text.substr(pos + 1, eq - pos - 1) + "]";
+        size_t end = text.find(close, eq + 1);
+        out = text.substr(eq + 1, end - eq - 1);
+        pos = end + close.size();
+    } else {
+        while (pos < text.size() && text[pos] != ' ' && text[pos] != ')' && text[pos] != '\n') {
+            out += text[pos++];
+        }
+    }
+    return true;
+}
+
+// 解析一个 CTestTestfile.cmake，subdirs() 里的子目录追加到 subdirs
+inline std::vector<TestBinary> ParseCTestFile(const std::string &text, const std::string &dir,
+                                              std::vector<std::string> *subdirs = nullptr)
+{
+    std::vector<TestBinary> tests;
+    size_t pos = 0;
+    while (pos < text.size()) {
+        size_t eol = text.find('\n', pos);
+        if (eol == std::string::npos) {
+            eol = text.size();
+        }
+        size_t paren = text.find('(', pos);
+        if (text[pos] == '#' || paren == std::string::npos || paren > eol) {
+            pos = eol + 1;
+            continue;
+        }
+        std::string cmd = text.substr(pos, paren - pos);
+        std::vector<std::string> args;
+        std::string arg;
+        size_t p = paren + 1;
+        while (ReadCMakeArg(text, p, arg)) {
+            args.push_back(arg);
+        }
+        pos = text.find('\n', p);
+        pos = pos == std::string::npos ? text.size() : pos + 1;
+
+        if (cmd == "add_test" && args.size() >= 2) {
+            TestBinary t;
+            t.name = args[0];
+            t.argv.assign(args.begin() + 1, args.end());
+            t.workdir = dir;
+            tests.push_back(std::move(t));
+        } else if (cmd == "set_tests_properties" && !args.empty()) {
+            for (size_t i = 1; i + 1 < args.size(); ++i) {
+                if (args[i] != "WORKING_DIRECTORY") {
+                    continue;
+                }
+                for (TestBinary &t : tests) {
+                    if (t.name == args[0]) {
+                        t.workdir = args[i + 1];
+                    }
+                }
+            }
+        } else if (cmd == "subdirs" && subdirs) {
+            for (const std::string &s : args) {
+                subdirs->push_back(s[0] == '/' ? s : dir + "/" + s);
+            }
+        }
+    }
+    return tests;
+}
+
+// 每个可执行文件上一次完整运行的总耗时（毫秒），以 "耗时\t路径" 的文本格式保存
+class History
+{
+public:
+    bool load(const std::string &path)
+    {
+        std::ifstream in(path);
+        if (!in) {
+            return false;
+        }
+        double ms;
+        std::string key;
+        while (in >> ms && in.get() == '\t' && std::getline(in, key)) {
+            _ms[key] = ms;
+        }
+        return true;
+    }
+
+    bool save(const std::string &path) const
+    {
+        std::ofstream out(path, std::ios::trunc);
+        for (const auto &kv : _ms) {
+            out << kv.second << '\t' << kv.first << '\n';
+        }
+        return static_cast<bool>(out);
+    }
+
+    bool find(const std::string &key, double &ms) const
+    {
+        auto it = _ms.find(key);
+        if (it == _ms.end()) {
+            return false;
+        }
+        ms = it->second;
+        return true;
+    }
+
+    void set(const std::string &key, double ms) { _ms[key] = ms; }
+    size_t size() const { return _ms.size(); }
+
+private:
+    std::map<std::string, double> _ms;
+};
+
+struct Shard
+{
+    size_t binary;      // 在 binaries 里的下标
+    int index;
+    int total;
+    double estimateMs;  // 没有历史记录时为 HUGE_VAL，排在最前面
+};
+
+// 决定分片：有历史数据时每个分片大约 targetMs，没有时按 jobs 切满；
+// 分片数不超过测试用例数。结果按预计耗时从长到短排序（LPT 调度）
+inline std::vector<Shard> Plan(const std::vector<TestBinary> &binaries, const std::vector<int> &testCounts,
+                               const History &history, int jobs, double targetMs)
+{
+    std::vector<Shard> shards;
+    for (size_t b = 0; b < binaries.size(); ++b) {
+        int limit = std::max(1, std::min(jobs, testCounts[b]));
+        double total;
+        int n = limit;
+        double each = HUGE_VAL;
+        if (history.find(binaries[b].argv[0], total)) {
+            n = std::max(1, std::min(limit, static_cast<int>(std::ceil(total / targetMs))));
+            each = total / n;
+        }
+        for (int i = 0; i < n; ++i) {
+            shards.push_back(Shard {b, i, n, each});
+        }
+    }
+    std::stable_sort(shards.begin(), shards.end(), [](const Shard &a, const Shard &b) {
+        return a.estimateMs > b.estimateMs;
+    });
+    return shards;
+}
+
+inline std::string XmlAttr(const std::string &tag, const std::string &name)
+{
+    std::string key = " " + name + "=\"";
+    size_t pos = tag.find(key);
+    if (pos == std::string::npos) {
+        return std::string();
+    }
+    pos += key.size();
+    return tag.substr(pos, tag.find('"', pos) - pos);
+}
+
+inline std::string XmlUnescape(const std::string &s)
+{
+    static const std::pair<const char *, char> kEntities[] = {
+        {"&amp;", '&'}, {"&lt;", '<'}, {"&gt;", '>'}, {"&quot;", '"'}, {"&apos;", '\''},
+    };
+    std::string out;
+    for (size_t i = 0; i < s.size(); ++i) {
+        bool matched = false;
+        if (s[i] == '&') {
+            for (const auto &e : kEntities) {
+                size_t len = std::char_traits<char>::length(e.first);
+                if (s.compare(i, len, e.first) == 0) {
+                    out += e.second;
+                    i += len - 1;
+                    matched = true;
+                    break;
+                }
+            }
+            if (!matched && s.compare(i, 3, "&#x") == 0) {
+                size_t semi = s.find(';', i);
+                out += static_cast<char>(std::strtol(s.c_str() + i + 3, nullptr, 16));
+                i = semi;
+                matched = true;
+            }
+        }
+        if (!matched) {
+            out += s[i];
+        }
+    }
+    return out;
+}
+
+inline std::string XmlEscape(const std::string &s)
+{
+    std::string out;
+    for (char c : s) {
+        switch (c) {
+        case '&': out += "&amp;"; break;
+        case '<': out += "&lt;"; break;
+        case '>': out += "&gt;"; break;
+        case '"': out += "&quot;"; break;
+        default: out += c;
+        }
+    }
+    return out;
+}
+
+inline std::string JsonEscape(const std::string &s)
+{
+    std::string out;
+    for (unsigned char c : s) {
+        if (c == '"' || c == '\\') {
+            out += '\\';
+            out += static_cast<char>(c);
+        } else if (c == '\n') {
+            out += "\\n";
+        } else if (c < 0x20) {
+            char buf[8];
+            std::snprintf(buf, sizeof(buf), "\\u%04x", c);
+            out += buf;
+        } else {
+            out += static_cast<char>(c);
+        }
+    }
+    return out;
+}
+
+struct TestCase
+{
+    std::string name;
+    std::string classname;
+    std::string status;     // run / notrun
+    std::string result;     // completed / skipped / ...
+    double time = 0;
+    std::vector<std::string> failures;
+    std::string xml;        // 原始的 <testcase> 元素，合并 XML 时原样输出
+    bool error = false;     // 分片出错的占位记录，只计入 errors，不算测试也不算失败
+};
+
+struct Suite
+{
+    Suite(std::string binary, std::string name)
+    : binary(std::move(binary))
+    , name(std::move(name))
+    {}
+
+    std::string binary;
+    std::string name;
+    double time = 0;
+    std::vector<TestCase> cases;
+};
+
+// 合并多个分片的结果；同一个可执行文件同名的测试套件被拆到多个分片里时会合回一个
+class Report
+{
+public:
+    // 解析一个分片的 gtest XML 输出，失败返回 false（比如进程崩溃没写完文件）
+    bool addXml(const std::string &binary, const std::string &xml)
+    {
+        if (xml.find("</testsuites>") == std::string::npos) {
+            return false;
+        }
+        size_t pos = 0;
+        while ((pos = xml.find("<testsuite ", pos)) != std::string::npos) {
+            size_t tagEnd = xml.find('>', pos);
+            std::string tag = xml.substr(pos, tagEnd - pos);
+            Suite &suite = get(binary, XmlUnescape(XmlAttr(tag, "name")));
+            suite.time += std::atof(XmlAttr(tag, "time").c_str());
+            size_t end = tag.back() == '/' ? tagEnd : xml.find("</testsuite>", tagEnd);
+            size_t c = tagEnd;
+            while ((c = xml.find("<testcase ", c)) != std::string::npos && c < end) {
+                size_t cTagEnd = xml.find('>', c);
+                std::string cTag = xml.substr(c, cTagEnd - c);
+                size_t cEnd = cTag.back() == '/' ? cTagEnd + 1 : xml.find("</testcase>", cTagEnd) + 11;
+                TestCase tc;
+                tc.name = XmlUnescape(XmlAttr(cTag, "name"));
+                tc.classname = XmlUnescape(XmlAttr(cTag, "classname"));
+                tc.status = XmlAttr(cTag, "status");
+                tc.result = XmlAttr(cTag, "result");
+                tc.time = std::atof(XmlAttr(cTag, "time").c_str());
+                tc.xml = xml.substr(c, cEnd - c);
+                for (size_t f = cTagEnd; (f = xml.find("<failure ", f)) != std::string::npos && f < cEnd; ++f) {
+                    tc.failures.push_back(XmlUnescape(XmlAttr(xml.substr(f, xml.find('>', f) - f), "message")));
+                }
+                // 合并后的报告里 addError 写入的记录，再次解析时仍然只算错误
+                size_t e = xml.find("<error ", cTagEnd);
+                if (e != std::string::npos && e < cEnd) {
+                    tc.error = true;
+                    tc.failures.push_back(XmlUnescape(XmlAttr(xml.substr(e, xml.find('>', e) - e), "message")));
+                    ++_errors;
+                }
+                suite.cases.push_back(std::move(tc));
+                c = cEnd;
+            }
+            pos = end;
+        }
+        return true;
+    }
+
+    // 分片没有产生可用的报告（崩溃、超时、非 0 退出但没有失败记录），记成一个错误
+    // 报告里留一条 <error> 记录说明原因，但它不计入 tests / failures
+    void addError(const std::string &binary, const std::string &shard, const std::string &message)
+    {
+        ++_errors;
+        Suite &suite = get(binary, "ShardRunner");
+        TestCase tc;
+        tc.name = shard;
+        tc.classname = "ShardRunner";
+        tc.status = "run";
+        tc.result = "completed";
+        tc.failures.push_back(message);
+        tc.error = true;
+        tc.xml = "<testcase name=\"" + XmlEscape(shard) + "\" status=\"run\" result=\"completed\" time=\"0\""
+                 " classname=\"ShardRunner\">\n      <error message=\"" + XmlEscape(message) +
+                 "\" type=\"\"></error>\n    </testcase>";
+        suite.cases.push_back(std::move(tc));
+    }
+
+    struct Totals
+    {
+        int tests = 0;
+        int failures = 0;
+        int disabled = 0;
+        int skipped = 0;
+        int errors = 0;
+        double time = 0;
+    };
+
+    static Totals Count(const Suite &suite)
+    {
+        Totals t;
+        t.time = suite.time;
+        for (const TestCase &tc : suite.cases) {
+            if (tc.error) {
+                ++t.errors;
+                continue;
+            }
+            ++t.tests;
+            t.failures += !tc.failures.empty();
+            t.disabled += tc.status == "notrun";
+            t.skipped += tc.result == "skipped";
+        }
+        return t;
+    }
+
+    Totals totals() const
+    {
+        Totals all;
+        for (const Suite &s : _suites) {
+            Totals t = Count(s);
+            all.tests += t.tests;
+            all.failures += t.failures;
+            all.disabled += t.disabled;
+            all.skipped += t.skipped;
+            all.errors += t.errors;
+            all.time += t.time;
+        }
+        return all;
+    }
+
+    int errors() const { return _errors; }
+    const std::vector<Suite> &suites() const { return _suites; }
+
+    void writeXml(std::ostream &out) const
+    {
+        Totals all = totals();
+        out << "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+            << "<testsuites tests=\"" << all.tests << "\" failures=\"" << all.failures
+            << "\" disabled=\"" << all.disabled << "\" skipped=\"" << all.skipped
+            << "\" errors=\"" << _errors << "\" time=\"" << all.time << "\" name=\"AllTests\">\n";
+        for (const Suite &s : _suites) {
+            Totals t = Count(s);
+            out << "  <testsuite name=\"" << XmlEscape(s.name) << "\" binary=\"" << XmlEscape(s.binary)
+                << "\" tests=\"" << t.tests << "\" failures=\"" << t.failures << "\" disabled=\""
+                << t.disabled << "\" skipped=\"" << t.skipped << "\" errors=\"" << t.errors << "\" time=\"" << t.time << "\">\n";
+            for (const TestCase &tc : s.cases) {
+                out << "    " << tc.xml << "\n";
+            }
+            out << "  </testsuite>\n";
+        }
+        out << "</testsuites>\n";
+    }
+
+    // 字段名沿用 gtest 自己的 JSON 输出格式
+    void writeJson(std::ostream &out) const
+    {
+        Totals all = totals();
+        out << "{\n  \"tests\": " << all.tests << ",\n  \"failures\": " << all.failures
+            << ",\n  \"disabled\": " << all.disabled << ",\n  \"skipped\": " << all.skipped
+            << ",\n  \"errors\": " << _errors << ",\n  \"time\": \"" << all.time
+            << "s\",\n  \"name\": \"AllTests\",\n  \"testsuites\": [";
+        for (size_t i = 0; i < _suites.size(); ++i) {
+            const Suite &s = _suites[i];
+            Totals t = Count(s);
+            out << (i ? "," : "") << "\n    {\n      \"name\": \"" << JsonEscape(s.name)
+                << "\",\n      \"binary\": \"" << JsonEscape(s.binary) << "\",\n      \"tests\": " << t.tests
+                << ",\n      \"failures\": " << t.failures << ",\n      \"disabled\": " << t.disabled
+                << ",\n      \"skipped\": " << t.skipped << ",\n      \"errors\": " << t.errors
+                << ",\n      \"time\": \"" << t.time
+                << "s\",\n      \"testsuite\": [";
+            for (size_t j = 0; j < s.cases.size(); ++j) {
+                const TestCase &tc = s.cases[j];
+                std::string status = tc.status, result = tc.result;
+                std::transform(status.begin(), status.end(), status.begin(), ::toupper);
+                std::transform(result.begin(), result.end(), result.begin(), ::toupper);
+                out << (j ? "," : "") << "\n        {\n          \"name\": \"" << JsonEscape(tc.name)
+                    << "\",\n          \"status\": \"" << status << "\",\n          \"result\": \"" << result
+                    << "\",\n          \"time\": \"" << tc.time << "s\",\n          \"classname\": \""
+                    << JsonEscape(tc.classname) << "\"";
+                if (!tc.failures.empty()) {
+                    const char *kind = tc.error ? "error" : "failure";
+                    out << ",\n          \"" << kind << "s\": [";
+                    for (size_t f = 0; f < tc.failures.size(); ++f) {
+                        out << (f ? ", " : "") << "{\"" << kind << "\": \"" << JsonEscape(tc.failures[f])
+                            << "\", \"type\": \"\"}";
+                    }
+                    out << "]";
+                }
+                out << "\n        }";
+            }
+            out << "\n      ]\n    }";
+        }
+        out << "\n  ]\n}\n";
+    }
+
+private:
+    Suite &get(const std::string &binary, const std::string &name)
+    {
+        auto key = std::make_pair(binary, name);
+        auto it = _index.find(key);
+        if (it != _index.end()) {
+            return _suites[it->second];
+        }
+        _index.emplace(key, _suites.size());
+        _suites.emplace_back(binary, name);
+        return _suites.back();
+    }
+
+    std::vector<Suite> _suites;
+    std::map<std::pair<std::string, std::string>, size_t> _index;
+    int _errors = 0;
+};
+
+} // namespace shard
+
+#endif
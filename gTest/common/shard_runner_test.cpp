@@ -0,0 +1,154 @@
+#include "shard_runner.h"
+#include <gtest/gtest.h>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace shard;
+
+TEST(ShardRunnerTest, ParseCTestFile)
+{
+    const char *text =
+        "# CMake generated Testfile for \n"
+        "add_test(CallParam \"/build/21/call_param\")\n"
+        "set_tests_properties(CallParam PROPERTIES  _BACKTRACE_TRIPLES \"x;19;add_test\")\n"
+        "add_test([=[Args]=] \"/build/21/args\" \"--flag\" \"a b\")\n"
+        "set_tests_properties([=[Args]=] PROPERTIES WORKING_DIRECTORY \"/work\")\n"
+        "subdirs(\"nested\")\n";
+    std::vector<std::string> subdirs;
+    std::vector<TestBinary> tests = ParseCTestFile(text, "/build/21", &subdirs);
+    ASSERT_EQ(tests.size(), 2);
+    EXPECT_EQ(tests[0].name, "CallParam");
+    EXPECT_EQ(tests[0].argv, (std::vector<std::string> {"/build/21/call_param"}));
+    EXPECT_EQ(tests[0].workdir, "/build/21");
+    EXPECT_EQ(tests[0].label(), "call_param");
+    EXPECT_EQ(tests[1].name, "Args");
+    EXPECT_EQ(tests[1].argv, (std::vector<std::string> {"/build/21/args", "--flag", "a b"}));
+    EXPECT_EQ(tests[1].workdir, "/work");
+    EXPECT_EQ(subdirs, (std::vector<std::string> {"/build/21/nested"}));
+}
+
+TEST(ShardRunnerTest, PlanLongestFirst)
+{
+    std::vector<TestBinary> bins(3);
+    bins[0].argv = {"/a"};
+    bins[1].argv = {"/b"};
+    bins[2].argv = {"/c"};
+    History history;
+    history.set("/a", 100);
+    history.set("/b", 1000);
+    // /c 没有历史记录
+
+    std::vector<Shard> plan = Plan(bins, {10, 2, 5}, history, 4, 200);
+    // /a: 1 片；/b: ceil(1000/200)=5 但只有 2 个用例 → 2 片；/c: 按 jobs 切成 4 片
+    ASSERT_EQ(plan.size(), 1 + 2 + 4);
+    for (int i = 0; i < 4; ++i) {
+        EXPECT_EQ(plan[i].binary, 2);
+        EXPECT_EQ(plan[i].total, 4);
+    }
+    EXPECT_EQ(plan[4].binary, 1);
+    EXPECT_DOUBLE_EQ(plan[4].estimateMs, 500);
+    EXPECT_EQ(plan[5].binary, 1);
+    EXPECT_EQ(plan[6].binary, 0);
+    EXPECT_EQ(plan[6].total, 1);
+}
+
+static const char *kShard0 =
+    "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+    "<testsuites tests=\"2\" failures=\"1\" disabled=\"0\" errors=\"0\" time=\"0.1\" name=\"AllTests\">\n"
+    "  <testsuite name=\"CalcTest\" tests=\"2\" failures=\"1\" disabled=\"0\" skipped=\"0\" errors=\"0\" time=\"0.1\">\n"
+    "    <testcase name=\"Ok\" status=\"run\" result=\"completed\" time=\"0.05\" classname=\"CalcTest\" />\n"
+    "    <testcase name=\"Bad\" status=\"run\" result=\"completed\" time=\"0.05\" classname=\"CalcTest\">\n"
+    "      <failure message=\"a.cpp:3&#x0A;Expected: 1 &lt; 2\" type=\"\"><![CDATA[a.cpp:3]]></failure>\n"
+    "    </testcase>\n"
+    "  </testsuite>\n"
+    "</testsuites>\n";
+
+static const char *kShard1 =
+    "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+    "<testsuites tests=\"2\" failures=\"0\" disabled=\"1\" errors=\"0\" time=\"0.2\" name=\"AllTests\">\n"
+    "  <testsuite name=\"CalcTest\" tests=\"2\" failures=\"0\" disabled=\"1\" skipped=\"0\" errors=\"0\" time=\"0.2\">\n"
+    "    <testcase name=\"Other\" status=\"run\" result=\"completed\" time=\"0.2\" classname=\"CalcTest\" />\n"
+    "    <testcase name=\"DISABLED_Off\" status=\"notrun\" result=\"suppressed\" time=\"0\" classname=\"CalcTest\" />\n"
+    "  </testsuite>\n"
+    "</testsuites>\n";
+
+TEST(ShardRunnerTest, MergeShardsOfSameSuite)
+{
+    Report report;
+    ASSERT_TRUE(report.addXml("call_param", kShard0));
+    ASSERT_TRUE(report.addXml("call_param", kShard1));
+    ASSERT_TRUE(report.addXml("other", kShard1));
+    ASSERT_EQ(report.suites().size(), 2);
+    EXPECT_EQ(report.suites()[0].cases.size(), 4);
+    EXPECT_EQ(report.suites()[0].cases[1].failures,
+              (std::vector<std::string> {"a.cpp:3\nExpected: 1 < 2"}));
+
+    Report::Totals all = report.totals();
+    EXPECT_EQ(all.tests, 6);
+    EXPECT_EQ(all.failures, 1);
+    EXPECT_EQ(all.disabled, 2);
+    EXPECT_NEAR(all.time, 0.5, 1e-9);
+}
+
+TEST(ShardRunnerTest, TruncatedXmlIsAnError)
+{
+    Report report;
+    std::string partial(kShard0);
+    partial.resize(partial.size() / 2);
+    EXPECT_FALSE(report.addXml("call_param", partial));
+    report.addError("call_param", "shard_1_of_2", "killed by signal 11");
+    EXPECT_EQ(report.errors(), 1);
+    // 崩溃的分片只算错误，不算测试，也不算失败
+    EXPECT_EQ(report.totals().tests, 0);
+    EXPECT_EQ(report.totals().failures, 0);
+    EXPECT_EQ(report.totals().errors, 1);
+}
+
+TEST(ShardRunnerTest, ErrorsSurviveMergedReport)
+{
+    Report report;
+    report.addXml("call_param", kShard0);
+    report.addXml("call_param", kShard1);
+    report.addError("call_param", "shard_2_of_3", "killed by signal 11");
+
+    std::ostringstream xml;
+    report.writeXml(xml);
+    EXPECT_NE(xml.str().find("<testsuites tests=\"4\" failures=\"1\" disabled=\"1\" skipped=\"0\" errors=\"1\""),
+              std::string::npos);
+    EXPECT_NE(xml.str().find("<error message=\"killed by signal 11\""), std::string::npos);
+
+    Report again;
+    ASSERT_TRUE(again.addXml("call_param", xml.str()));
+    EXPECT_EQ(again.totals().tests, 4);
+    EXPECT_EQ(again.totals().failures, 1);
+    EXPECT_EQ(again.errors(), 1);
+
+    std::ostringstream json;
+    report.writeJson(json);
+    EXPECT_NE(json.str().find("\"tests\": 4"), std::string::npos);
+    EXPECT_NE(json.str().find("\"errors\": 1"), std::string::npos);
+    EXPECT_NE(json.str().find("{\"error\": \"killed by signal 11\""), std::string::npos);
+}
+
+TEST(ShardRunnerTest, WriteReports)
+{
+    Report report;
+    report.addXml("call_param", kShard0);
+    report.addXml("call_param", kShard1);
+
+    std::ostringstream xml;
+    report.writeXml(xml);
+    // 合并后的 XML 本身能被再次解析，并且数量一致
+    Report again;
+    ASSERT_TRUE(again.addXml("call_param", xml.str()));
+    EXPECT_EQ(again.totals().tests, 4);
+    EXPECT_EQ(again.totals().failures, 1);
+    EXPECT_NE(xml.str().find("<testsuites tests=\"4\" failures=\"1\" disabled=\"1\""), std::string::npos);
+
+    std::ostringstream json;
+    report.writeJson(json);
+    EXPECT_NE(json.str().find("\"tests\": 4"), std::string::npos);
+    EXPECT_NE(json.str().find("\"failure\": \"a.cpp:3\\nExpected: 1 < 2\""), std::string::npos);
+    EXPECT_NE(json.str().find("\"status\": \"NOTRUN\""), std::string::npos);
+}
@@ -0,0 +1,166 @@
+#ifndef __TEST_TIMING_H__
+#define __TEST_TIMING_H__
+
+#include <gtest/gtest.h>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <sys/resource.h>
+#include <unistd.h>
+
+// 记录每个测试（以及每个测试套件）的墙钟时间、线程 CPU 时间和内存峰值
+// 每条记录输出一行 JSON（NDJSON），便于跨多次运行、多个可执行文件汇总比较：
+// {"type":"test","binary":"test_add","suite":"AddTest","name":"cast1","status":"passed",
+//  "start_ms":1700000000000,"wall_ms":0.012,"cpu_ms":0.010,"max_rss_kb":4096,"rss_growth_kb":0}
+//
+// max_rss_kb 是进程从启动到这条记录为止的峰值 RSS（ru_maxrss），不是这个测试自己的峰值；
+// rss_growth_kb 是这个测试期间进程峰值涨了多少，没有超过之前的峰值时为 0
+//
+// 在 main 里 InitGoogleTest 之后调用一次 InstallTestTiming() 即可
+// 输出位置：参数 path > 环境变量 GTEST_TIMING_OUTPUT > 当前目录的 test_timing.ndjson（追加写）
+class TimingListener : public ::testing::EmptyTestEventListener
+{
+public:
+    TimingListener(std::ostream &out, std::string binary)
+    : _out(out)
+    , _binary(std::move(binary))
+    {}
+
+    void OnTestSuiteStart(const ::testing::TestSuite &) override
+    {
+        _suite = Sample::now();
+    }
+
+    void OnTestStart(const ::testing::TestInfo &) override
+    {
+        _test = Sample::now();
+    }
+
+    void OnTestEnd(const ::testing::TestInfo &info) override
+    {
+        const ::testing::TestResult *result = info.result();
+        const char *status = result->Skipped() ? "skipped" : result->Passed() ? "passed" : "failed";
+        write("test", info.test_suite_name(), info.name(), status, _test, Sample::now());
+    }
+
+    void OnTestSuiteEnd(const ::testing::TestSuite &suite) override
+    {
+        write("suite", suite.name(), nullptr, suite.Passed() ? "passed" : "failed", _suite, Sample::now());
+    }
+
+private:
+    struct Sample
+    {
+        std::chrono::system_clock::time_point wallClock;
+        std::chrono::steady_clock::time_point wall;
+        double cpuMs;
+        long maxRssKb;
+
+        static Sample now()
+        {
+            Sample s;
+            s.wallClock = std::chrono::system_clock::now();
+            s.wall = std::chrono::steady_clock::now();
+            timespec ts;
+            clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+            s.cpuMs = ts.tv_sec * 1e3 + ts.tv_nsec / 1e6;
+            rusage usage;
+            getrusage(RUSAGE_SELF, &usage);
+            s.maxRssKb = usage.ru_maxrss;
+            return s;
+        }
+    };
+
+    void write(const char *type, const char *suite, const char *name, const char *status,
+               const Sample &begin, const Sample &end)
+    {
+        using namespace std::chrono;
+        char numbers[192];
+        std::snprintf(numbers, sizeof(numbers),
+                      "\"start_ms\":%lld,\"wall_ms\":%.3f,\"cpu_ms\":%.3f,"
+                      "\"max_rss_kb\":%ld,\"rss_growth_kb\":%ld",
+                      static_cast<long long>(duration_cast<milliseconds>(
+                          begin.wallClock.time_since_epoch()).count()),
+                      duration<double, std::milli>(end.wall - begin.wall).count(),
+                      end.cpuMs - begin.cpuMs, end.maxRssKb, end.maxRssKb - begin.maxRssKb);
+
+        std::string line = "{\"type\":\"";
+        line += type;
+        line += "\",\"binary\":";
+        appendQuoted(line, _binary.c_str());
+        line += ",\"suite\":";
+        appendQuoted(line, suite);
+        if (name) {
+            line += ",\"name\":";
+            appendQuoted(line, name);
+        }
+        line += ",\"status\":\"";
+        line += status;
+        line += "\",";
+        line += numbers;
+        line += "}\n";
+        _out << line << std::flush;
+    }
+
+    static void appendQuoted(std::string &out, const char *s)
+    {
+        out += '"';
+        for (; *s; ++s) {
+            unsigned char c = static_cast<unsigned char>(*s);
+            if (c == '"' || c == '\\') {
+                out += '\\';
+                out += static_cast<char>(c);
+            } else if (c < 0x20) {
+                char buf[8];
+                std::snprintf(buf, sizeof(buf), "\\u%04x", c);
+                out += buf;
+            } else {
+                out += static_cast<char>(c);
+            }
+        }
+        out += '"';
+    }
+
+    std::ostream &_out;
+    std::string _binary;
+    Sample _suite {};
+    Sample _test {};
+};
+
+inline std::string CurrentBinaryName()
+{
+    char path[4096];
+    ssize_t n = readlink("/proc/self/exe", path, sizeof(path) - 1);
+    if (n <= 0) {
+        return "unknown";
+    }
+    path[n] = '\0';
+    std::string s(path);
+    return s.substr(s.find_last_of('/') + 1);
+}
+
+// 注册到 gtest 的监听器列表，gtest 负责释放监听器；输出文件在程序结束时关闭
+inline void InstallTestTiming(const char *path = nullptr)
+{
+    if (!path) {
+        path = std::getenv("GTEST_TIMING_OUTPUT");
+    }
+    if (!path || !*path) {
+        path = "test_timing.ndjson";
+    }
+    static std::ofstream out;
+    if (!out.is_open()) {
+        out.open(path, std::ios::app);
+    }
+    std::ostream &stream = out.is_open() ? static_cast<std::ostream &>(out) : std::cerr;
+    ::testing::UnitTest::GetInstance()->listeners().Append(
+        new TimingListener(stream, CurrentBinaryName()));
+}
+
+#endif
@@ -0,0 +1,124 @@
+#include "test_timing.h"
+#include <gtest/gtest.h>
+#include <chrono>
+#include <cstdlib>
+#include <ctime>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+static double ThreadCpuMs()
+{
+    timespec ts;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return ts.tv_sec * 1e3 + ts.tv_nsec / 1e6;
+}
+
+static double NumberField(const std::string &line, const std::string &key)
+{
+    auto pos = line.find("\"" + key + "\":");
+    if (pos == std::string::npos) {
+        return -1;
+    }
+    return std::stod(line.substr(pos + key.size() + 3));
+}
+
+// 在测试内部直接驱动监听器，检查输出的那一行 JSON
+TEST(TimingListenerTest, RecordsWallAndCpuTime)
+{
+    std::ostringstream out;
+    TimingListener listener(out, "timing_test");
+    const ::testing::TestInfo &info = *::testing::UnitTest::GetInstance()->current_test_info();
+
+    listener.OnTestStart(info);
+    // 按线程 CPU 时间计时：机器忙的时候墙钟时间走完了，CPU 时间不一定够
+    volatile double sink = 0;
+    double until = ThreadCpuMs() + 15;
+    while (ThreadCpuMs() < until) {
+        sink = sink + 1;
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    listener.OnTestEnd(info);
+
+    std::string line = out.str();
+    ASSERT_FALSE(line.empty());
+    EXPECT_EQ(line.back(), '\n');
+    EXPECT_EQ(line.find('\n'), line.size() - 1);
+    EXPECT_NE(line.find("\"type\":\"test\""), std::string::npos);
+    EXPECT_NE(line.find("\"binary\":\"timing_test\""), std::string::npos);
+    EXPECT_NE(line.find("\"suite\":\"TimingListenerTest\""), std::string::npos);
+    EXPECT_NE(line.find("\"name\":\"RecordsWallAndCpuTime\""), std::string::npos);
+    EXPECT_NE(line.find("\"status\":\"passed\""), std::string::npos);
+
+    double wall = NumberField(line, "wall_ms");
+    double cpu = NumberField(line, "cpu_ms");
+    EXPECT_GE(wall, 35);
+    EXPECT_GE(cpu, 15);
+    // sleep 的那段不计入线程 CPU 时间
+    EXPECT_LT(cpu, wall - 10);
+    EXPECT_GT(NumberField(line, "max_rss_kb"), 0);
+    EXPECT_GE(NumberField(line, "rss_growth_kb"), 0);
+    EXPECT_GT(NumberField(line, "start_ms"), 0);
+}
+
+TEST(TimingListenerTest, ReportsPeakRssGrowth)
+{
+    std::ostringstream out;
+    TimingListener listener(out, "timing_test");
+    const ::testing::TestInfo &info = *::testing::UnitTest::GetInstance()->current_test_info();
+
+    // 比进程之前的峰值再多 64MB，不管前面跑过什么测试，峰值都一定会涨
+    rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+    listener.OnTestStart(info);
+    std::vector<char> big((usage.ru_maxrss << 10) + (64 << 20), 1);
+    listener.OnTestEnd(info);
+
+    EXPECT_GE(NumberField(out.str(), "rss_growth_kb"), 60 * 1024) << static_cast<int>(big[12345]);
+    EXPECT_GE(NumberField(out.str(), "max_rss_kb"), usage.ru_maxrss + 60 * 1024);
+}
+
+// 以子进程重新跑一遍本程序里的一个测试，输出写到这次新建的临时文件，
+// 不依赖测试顺序，也不会读到当前目录下以前运行留下的记录
+TEST(TimingListenerTest, InstalledListenerWritesFile)
+{
+    char path[] = "/tmp/test_timing_XXXXXX";
+    int fd = mkstemp(path);
+    ASSERT_GE(fd, 0);
+    close(fd);
+
+    pid_t pid = fork();
+    ASSERT_GE(pid, 0);
+    if (pid == 0) {
+        setenv("GTEST_TIMING_OUTPUT", path, 1);
+        // 不继承外面的分片和输出设置
+        unsetenv("GTEST_SHARD_INDEX");
+        unsetenv("GTEST_TOTAL_SHARDS");
+        unsetenv("GTEST_OUTPUT");
+        execl("/proc/self/exe", "test_timing_test", "--gtest_filter=TimingListenerTest.RecordsWallAndCpuTime",
+              static_cast<char *>(nullptr));
+        _exit(127);
+    }
+    int status = 0;
+    ASSERT_EQ(waitpid(pid, &status, 0), pid);
+    ASSERT_TRUE(WIFEXITED(status) && WEXITSTATUS(status) == 0) << status;
+
+    std::ifstream in(path);
+    std::vector<std::string> lines;
+    for (std::string line; std::getline(in, line);) {
+        lines.push_back(line);
+    }
+    unlink(path);
+
+    // 一条测试记录加一条套件记录
+    ASSERT_EQ(lines.size(), 2);
+    EXPECT_NE(lines[0].find("\"type\":\"test\""), std::string::npos) << lines[0];
+    EXPECT_NE(lines[0].find("\"name\":\"RecordsWallAndCpuTime\""), std::string::npos) << lines[0];
+    EXPECT_NE(lines[0].find("\"status\":\"passed\""), std::string::npos) << lines[0];
+    EXPECT_NE(lines[1].find("\"type\":\"suite\""), std::string::npos) << lines[1];
+}
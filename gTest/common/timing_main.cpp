@@ -0,0 +1,9 @@
+#include "test_timing.h"
+#include <gtest/gtest.h>
+
+// 可以替代 libgtest_main.a：链接这个文件的测试程序自动记录每个测试的耗时
+int main(int argc, char **argv) {
+    testing::InitGoogleTest(&argc, argv);
+    InstallTestTiming();
+    return RUN_ALL_TESTS();
+}